@@ -2,9 +2,38 @@
 #include <stdlib.h>
 #include <math.h>
 #include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
 #include "WC_LinkedList.h"
 #include "sodium.h"
 
+//maximum number of skip list levels above the node chain of an indexed list.
+#define WC_SKIP_MAX_LEVELS 32
+
+//number of nodes the background reclaimer frees between checks for throttling.
+#define WC_RECLAIM_BATCH 4096
+
+//hint to the processor to start loading the memory at address, so that the
+//load overlaps with work on the current node. (no-op without the builtin).
+#if defined(__GNUC__) || defined(__clang__)
+    #define WC_PREFETCH(address) __builtin_prefetch(address)
+#else
+    #define WC_PREFETCH(address) ((void)(address))
+#endif
+
+struct node;
+
+//forward link of a node on one of the skip list levels above the node chain.
+struct skip_link {
+    //next node on this level. (NULL at the end of the level).
+    struct node* next;
+    //number of positions the link moves forward. when next is NULL it is the
+    //number of nodes after the owner of the link.
+    size_t span;
+};
+
 //List node
 struct node {
     //value that the node holds.
@@ -13,6 +42,9 @@ struct node {
     size_t value_length;
     //next node in the list.
     struct node* next;
+    //links for skip list levels 1 and up. only allocated for the levels a node
+    //of an indexed list takes part in; plain list nodes have none.
+    struct skip_link links[];
 };
 
 //List
@@ -25,6 +57,72 @@ struct linked_list {
     size_t length;
     //type of the element stored.
     enum linked_list_type e_type;
+    //allocator used for every allocation the list makes.
+    const struct wc_allocator* allocator;
+    //context passed to each allocator hook.
+    void* allocator_ctx;
+    //skip list links of the list head for levels 1 and up. NULL when the list
+    //is not indexed. (see linked_list_enable_index).
+    struct skip_link* skip_head;
+    //number of skip list levels in use above the node chain.
+    unsigned int skip_levels;
+    //state of the generator picking the height of new nodes.
+    uint64_t skip_rng;
+    //table the string values of the list are interned in. NULL when the list
+    //doesn't intern its values. (see linked_list_enable_interning).
+    struct linked_list_intern_table* intern;
+    //1 when intern is private to the list and freed with it.
+    unsigned char owns_intern;
+    //block the list was last compacted into. NULL when the list has not been
+    //compacted, or every node and value in the block has been freed.
+    struct node_arena* arena;
+    //caller defined equality and hash of elements. NULL to use the rules of
+    //the list type. (see linked_list_set_ops).
+    linked_list_eq_fn eq_fn;
+    linked_list_hash_fn hash_fn;
+    //context passed to eq_fn and hash_fn.
+    void* ops_ctx;
+    //next list waiting for the background reclaimer. (see linked_list_free_async).
+    struct linked_list* reclaim_next;
+};
+
+//Block of memory a list was compacted into. (see linked_list_compact). nodes
+//and values in it are released by counting, and the block is freed with the
+//last of them.
+struct node_arena {
+    //number of nodes and values still stored in the block.
+    size_t live;
+    //bytes of storage in the block.
+    size_t size;
+    //the storage itself, nodes and values in list order.
+    max_align_t storage[];
+};
+
+//Interned string: one refcounted buffer shared by every node holding it.
+struct intern_entry {
+    //next entry in the same bucket.
+    struct intern_entry* next;
+    //hash of the string stored.
+    uint64_t hash;
+    //bytes of memory the string takes up.
+    size_t length;
+    //number of nodes holding the string.
+    size_t references;
+    //the string itself. node values point here.
+    char data[];
+};
+
+//Intern table
+struct linked_list_intern_table {
+    //chains of entries, indexed by hash. (bucket_count is a power of two).
+    struct intern_entry** buckets;
+    size_t bucket_count;
+    //number of distinct strings stored.
+    size_t count;
+    //allocator used for the table and its entries.
+    const struct wc_allocator* allocator;
+    //context passed to each allocator hook.
+    void* allocator_ctx;
 };
 
 //List iterator
@@ -38,8 +136,298 @@ struct linked_list_iterator {
     size_t current_index;
     //max iteration index
     size_t max_index;
+    //allocator of the list iterated over, used to free the iterator.
+    const struct wc_allocator* allocator;
+    //context passed to each allocator hook.
+    void* allocator_ctx;
+};
+
+/*
+* Error reporting
+*/
+
+//code of the last error raised on this thread.
+static _Thread_local enum linked_list_error last_error = WC_LINKEDLIST_OK;
+//optional user installed callback, called with every error raised.
+static linked_list_error_callback error_callback = NULL;
+//context passed to error_callback.
+static void* error_callback_ctx = NULL;
+
+//record an error for linked_list_last_error, and pass it on to the user's
+//error callback if one is installed. Does no I/O itself.
+static void set_error(enum linked_list_error error, const char* message) {
+    last_error = error;
+    if (error_callback != NULL) {
+        error_callback(error, message, error_callback_ctx);
+    }
+}
+
+//return the code of the last error raised on the calling thread.
+enum linked_list_error linked_list_last_error(void) {
+    return last_error;
+}
+
+//reset the last error of the calling thread to WC_LINKEDLIST_OK.
+void linked_list_clear_error(void) {
+    last_error = WC_LINKEDLIST_OK;
+}
+
+//install a callback called with every error raised. NULL removes it.
+void linked_list_set_error_callback(linked_list_error_callback callback, void* ctx) {
+    error_callback = callback;
+    error_callback_ctx = ctx;
+}
+
+//return a description of an error code.
+const char* linked_list_error_string(enum linked_list_error error) {
+    switch (error) {
+        case WC_LINKEDLIST_OK:
+            return "No error";
+        case WC_LINKEDLIST_ERROR_NULL_LIST:
+            return "NULL list passed";
+        case WC_LINKEDLIST_ERROR_NULL_VALUE:
+            return "NULL value passed";
+        case WC_LINKEDLIST_ERROR_NULL_ARGUMENT:
+            return "NULL or incomplete argument passed";
+        case WC_LINKEDLIST_ERROR_OUT_OF_BOUNDS:
+            return "Index out of bounds";
+        case WC_LINKEDLIST_ERROR_EMPTY_LIST:
+            return "List is empty";
+        case WC_LINKEDLIST_ERROR_OUT_OF_MEMORY:
+            return "Out of memory";
+        case WC_LINKEDLIST_ERROR_INVALID_STATE:
+            return "List is in an invalid state";
+        case WC_LINKEDLIST_ERROR_TYPE_MISMATCH:
+            return "Operation not supported for the type of the list";
+    }
+    return "Unknown error";
+}
+
+/*
+* Default allocator
+*/
+
+static void* default_alloc(size_t size, void* ctx) {
+    (void)ctx;
+    return malloc(size);
+}
+
+static void* default_realloc(void* ptr, size_t size, void* ctx) {
+    (void)ctx;
+    return realloc(ptr, size);
+}
+
+static void default_free(void* ptr, void* ctx) {
+    (void)ctx;
+    free(ptr);
+}
+
+//allocator used by lists created through linked_list_new.
+static const struct wc_allocator default_allocator = {
+    default_alloc, default_realloc, default_free, NULL
 };
 
+//allocate memory using the allocator of the list passed.
+static void* list_alloc(struct linked_list* list, size_t size) {
+    return list->allocator->alloc(size, list->allocator_ctx);
+}
+
+//reallocate memory using the allocator of the list passed.
+static void* list_realloc(struct linked_list* list, void* ptr, size_t size) {
+    return list->allocator->realloc(ptr, size, list->allocator_ctx);
+}
+
+//free memory using the allocator of the list passed.
+static void list_dealloc(struct linked_list* list, void* ptr) {
+    list->allocator->free(ptr, list->allocator_ctx);
+}
+
+//one if ptr points into the storage of arena, 0 otherwise.
+static unsigned char arena_contains(struct node_arena* arena, void* ptr) {
+    uintptr_t address = (uintptr_t)ptr;
+    uintptr_t start = (uintptr_t)arena->storage;
+    return address >= start && address - start < arena->size;
+}
+
+//free a node or value of the list passed. nodes and values in the list's
+//arena are counted off instead, freeing the arena with the last of them.
+static void list_release(struct linked_list* list, void* ptr) {
+    struct node_arena* arena = list->arena;
+    if (arena != NULL && arena_contains(arena, ptr)) {
+        if (--arena->live == 0) {
+            list_dealloc(list, arena);
+            list->arena = NULL;
+        }
+        return;
+    }
+    list_dealloc(list, ptr);
+}
+
+/*
+* Intern table functions
+*/
+
+//number of buckets an intern table starts with.
+#define WC_INTERN_INITIAL_BUCKETS 64
+
+//FNV-1a hash of a value.
+static uint64_t hash_bytes(const void* value, size_t length) {
+    const unsigned char* bytes = value;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+//create an intern table allocating through the allocator passed. will return
+//NULL on failure.
+static struct linked_list_intern_table* intern_table_create(const struct wc_allocator* allocator,
+                                                            void* ctx) {
+    struct linked_list_intern_table* table =
+        allocator->alloc(sizeof(struct linked_list_intern_table), ctx);
+    if (table == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_OUT_OF_MEMORY,
+                  "Error. System out of memory, allocating an intern table failed.\n");
+        return NULL;
+    }
+    table->buckets = allocator->alloc(WC_INTERN_INITIAL_BUCKETS * sizeof(struct intern_entry*),
+                                      ctx);
+    if (table->buckets == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_OUT_OF_MEMORY,
+                  "Error. System out of memory, allocating an intern table failed.\n");
+        allocator->free(table, ctx);
+        return NULL;
+    }
+    memset(table->buckets, 0, WC_INTERN_INITIAL_BUCKETS * sizeof(struct intern_entry*));
+    table->bucket_count = WC_INTERN_INITIAL_BUCKETS;
+    table->count = 0;
+    table->allocator = allocator;
+    table->allocator_ctx = ctx;
+    return table;
+}
+
+//retrieve the entry holding an interned string from its data.
+static struct intern_entry* intern_entry_of(void* data) {
+    return (struct intern_entry*)((char*)data - offsetof(struct intern_entry, data));
+}
+
+//find the interned copy of value. will return NULL when value isn't interned.
+static struct intern_entry* intern_lookup(struct linked_list_intern_table* table, uint64_t hash,
+                                          void* value, size_t obj_length) {
+    struct intern_entry* entry = table->buckets[hash & (table->bucket_count - 1)];
+    for (; entry != NULL; entry = entry->next) {
+        if (entry->hash == hash && entry->length == obj_length &&
+            memcmp(entry->data, value, obj_length) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+//double the number of buckets of a table. the table keeps working with its
+//current buckets if the allocation fails.
+static void intern_table_grow(struct linked_list_intern_table* table) {
+    size_t new_count = table->bucket_count * 2;
+    struct intern_entry** new_buckets =
+        table->allocator->alloc(new_count * sizeof(struct intern_entry*), table->allocator_ctx);
+    if (new_buckets == NULL) {
+        return;
+    }
+    memset(new_buckets, 0, new_count * sizeof(struct intern_entry*));
+    for (size_t i = 0; i < table->bucket_count; i++) {
+        struct intern_entry* entry = table->buckets[i];
+        while (entry != NULL) {
+            struct intern_entry* next = entry->next;
+            struct intern_entry** bucket = &new_buckets[entry->hash & (new_count - 1)];
+            entry->next = *bucket;
+            *bucket = entry;
+            entry = next;
+        }
+    }
+    table->allocator->free(table->buckets, table->allocator_ctx);
+    table->buckets = new_buckets;
+    table->bucket_count = new_count;
+}
+
+//take a reference to the interned copy of value, interning it first if
+//needed. returns the shared data, or NULL on failure.
+static void* intern_acquire(struct linked_list_intern_table* table, void* value,
+                            size_t obj_length) {
+    uint64_t hash = hash_bytes(value, obj_length);
+    struct intern_entry* entry = intern_lookup(table, hash, value, obj_length);
+    if (entry != NULL) {
+        entry->references++;
+        return entry->data;
+    }
+    entry = table->allocator->alloc(sizeof(struct intern_entry) + obj_length,
+                                    table->allocator_ctx);
+    if (entry == NULL) {
+        return NULL;
+    }
+    memcpy(entry->data, value, obj_length);
+    entry->hash = hash;
+    entry->length = obj_length;
+    entry->references = 1;
+    if (table->count >= table->bucket_count) {
+        intern_table_grow(table);
+    }
+    struct intern_entry** bucket = &table->buckets[hash & (table->bucket_count - 1)];
+    entry->next = *bucket;
+    *bucket = entry;
+    table->count++;
+    return entry->data;
+}
+
+//give back a reference to an interned string, freeing it when it was the last.
+static void intern_release(struct linked_list_intern_table* table, void* data) {
+    struct intern_entry* entry = intern_entry_of(data);
+    if (--entry->references > 0) {
+        return;
+    }
+    //unlink the entry from its bucket.
+    struct intern_entry** link = &table->buckets[entry->hash & (table->bucket_count - 1)];
+    while (*link != entry) {
+        link = &(*link)->next;
+    }
+    *link = entry->next;
+    table->count--;
+    table->allocator->free(entry, table->allocator_ctx);
+}
+
+//create an intern table that can be shared by string lists.
+struct linked_list_intern_table* linked_list_intern_table_new(void) {
+    return intern_table_create(&default_allocator, NULL);
+}
+
+//free an intern table, and every string still in it.
+void linked_list_intern_table_free(struct linked_list_intern_table* table) {
+    if (table == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_ARGUMENT,
+                  "Error. Attempting to free a NULL intern table.\n");
+        return;
+    }
+    for (size_t i = 0; i < table->bucket_count; i++) {
+        struct intern_entry* entry = table->buckets[i];
+        while (entry != NULL) {
+            struct intern_entry* next = entry->next;
+            table->allocator->free(entry, table->allocator_ctx);
+            entry = next;
+        }
+    }
+    table->allocator->free(table->buckets, table->allocator_ctx);
+    table->allocator->free(table, table->allocator_ctx);
+}
+
+//return the number of distinct strings in an intern table.
+size_t linked_list_intern_table_size(struct linked_list_intern_table* table) {
+    if (table == NULL) {
+        return 0;
+    }
+    return table->count;
+}
+
 /*
 * List iterator functions
 */
@@ -47,10 +435,14 @@ struct linked_list_iterator {
 //create a new linked_list_iterator and return it. will return NULL on failure.
 //Must be freed when done using.
 struct linked_list_iterator* linked_list_get_iterator(struct linked_list* list) {
-    struct linked_list_iterator* it = malloc(sizeof(struct linked_list_iterator));
-    //make sure that the system returned memory for the iterator, and that the
-    //list exists, and make sure the list has at least one element.
-    if (it == NULL || list == NULL || list->head == NULL || list->length == 0) {
+    //make sure that the list exists, and make sure the list has at least one
+    //element.
+    if (list == NULL || list->head == NULL || list->length == 0) {
+        return NULL;
+    }
+    struct linked_list_iterator* it = list_alloc(list, sizeof(struct linked_list_iterator));
+    //make sure that the allocator returned memory for the iterator.
+    if (it == NULL) {
         return NULL;
     }
     //initialize iterator values.
@@ -58,12 +450,17 @@ struct linked_list_iterator* linked_list_get_iterator(struct linked_list* list)
     it->is_new = 0;
     it->current_index = 0;
     it->max_index = list->length - 1;
+    it->allocator = list->allocator;
+    it->allocator_ctx = list->allocator_ctx;
     return it;
 }
 
 //free a linked list iterator
 void linked_list_free_iterator(struct linked_list_iterator* list_it) {
-    free(list_it);
+    if (list_it == NULL) {
+        return;
+    }
+    list_it->allocator->free(list_it, list_it->allocator_ctx);
 }
 
 //Function checks to see if there is another element in the list after the
@@ -115,6 +512,8 @@ void* linked_list_get_next(struct linked_list_iterator* list_it) {
         if (current == NULL) {
             return NULL;
         }
+        //start loading the element after it while the caller works on this one.
+        WC_PREFETCH(current->next);
         //move the iterator to the next element in the list.
         list_it->current = current;
         //increment the iterator's index
@@ -129,24 +528,263 @@ void* linked_list_get_next(struct linked_list_iterator* list_it) {
 */
 
 //function for freeing a single node.
-static void node_free(struct node* node_to_free) {
+static void node_free(struct linked_list* list, struct node* node_to_free) {
     if (node_to_free == NULL || node_to_free->value == NULL) { 
-        fputs("Error. Attempting to free NULL node.\n", stderr);
+        set_error(WC_LINKEDLIST_ERROR_INVALID_STATE,
+                  "Error. Attempting to free NULL node.\n");
         return;
     }
-    free(node_to_free->value);
-    free(node_to_free);
+    //interned values are shared, give back the node's reference instead.
+    if (list->intern != NULL) {
+        intern_release(list->intern, node_to_free->value);
+    } else {
+        list_release(list, node_to_free->value);
+    }
+    list_release(list, node_to_free);
 }
 
 //function for allocating memory for a new list element's value.
-static void* allocate_element(void* value, size_t obj_length) {
+static void* allocate_element(struct linked_list* list, void* value, size_t obj_length) {
     //allocate memory required for new element.
-    void* new_list_element = malloc(obj_length);
+    void* new_list_element = list_alloc(list, obj_length);
+    //make sure the allocation was successful before copying into it.
+    if (new_list_element == NULL) {
+        return NULL;
+    }
     //copy the passed value into it's new container.
     memcpy(new_list_element, value, obj_length);
     return new_list_element;
 }
 
+//bytes of memory a node with links on height skip list levels takes up.
+static size_t node_size(unsigned int height) {
+    return sizeof(struct node) + height * sizeof(struct skip_link);
+}
+
+//allocate a new node holding a copy of value, with room for links on height
+//skip list levels. will return NULL on failure.
+static struct node* node_new(struct linked_list* list, void* value, size_t obj_length,
+                             unsigned int height) {
+    //create a new node to add to the list.
+    struct node* new_node = list_alloc(list, node_size(height));
+    //make sure that the node allocation was successful.
+    if (new_node == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_OUT_OF_MEMORY,
+                  "Error. System out of memory, allocating a new node failed.\n");
+        return NULL;
+    }
+    //allocate a new container for the original value passed. (or share the
+    //interned copy of it).
+    void* new_value = (list->intern != NULL) ? intern_acquire(list->intern, value, obj_length)
+                                             : allocate_element(list, value, obj_length);
+    //make sure that allocation was successful.
+    if (new_value == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_OUT_OF_MEMORY,
+                  "Error. System out of memory, allocating a new element failed.\n");
+        list_dealloc(list, new_node);
+        return NULL;
+    }
+    new_node->value = new_value;
+    //set the length of the element stored into the node.
+    new_node->value_length = obj_length;
+    new_node->next = NULL;
+    return new_node;
+}
+
+//link node into the node chain after previous. (at the front of the list when
+//previous is NULL).
+static void node_link_after(struct linked_list* list, struct node* previous, struct node* node) {
+    if (previous == NULL) {
+        node->next = list->head;
+        list->head = node;
+    } else {
+        node->next = previous->next;
+        previous->next = node;
+    }
+    //node is the new end of the list.
+    if (node->next == NULL) {
+        list->tail = node;
+    }
+    list->length++;
+}
+
+//unlink node, which follows previous, from the node chain. (previous is NULL
+//when node is the head of the list).
+static void node_unlink_after(struct linked_list* list, struct node* previous, struct node* node) {
+    if (previous == NULL) {
+        list->head = node->next;
+    } else {
+        previous->next = node->next;
+    }
+    //the element before node is the new end of the list.
+    if (node == list->tail) {
+        list->tail = previous;
+    }
+    list->length--;
+}
+
+/*
+* Skip list functions (indexed lists only)
+*/
+
+//retrieve the link of x on a skip list level. x is NULL for the list head.
+static struct skip_link* skip_link_at(struct linked_list* list, struct node* x, unsigned int level) {
+    return (x == NULL) ? &list->skip_head[level - 1] : &x->links[level - 1];
+}
+
+//advance a xorshift64* generator and return its next value.
+static uint64_t xorshift64_star(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+//pick the number of skip list levels a new node takes part in. each level is
+//joined with a probability of 1/4.
+static unsigned int skip_random_height(struct linked_list* list) {
+    uint64_t random_bits = xorshift64_star(&list->skip_rng);
+    unsigned int height = 0;
+
+    while (height < WC_SKIP_MAX_LEVELS && (random_bits >> 62) == 0) {
+        height++;
+        random_bits <<= 2;
+    }
+    return height;
+}
+
+//find on every level the last node positioned before index. (NULL for the
+//list head). update[0] is the node before index on the node chain, ranks
+//receives the position + 1 of each node found. (0 for the list head).
+static void skip_find_predecessors(struct linked_list* list, size_t index,
+                                   struct node** update, size_t* ranks) {
+    struct node* x = NULL;
+    size_t rank = 0;
+
+    for (unsigned int level = list->skip_levels; level > 0; level--) {
+        struct skip_link* link = skip_link_at(list, x, level);
+        //move forward as long as the link doesn't pass index.
+        while (link->next != NULL && rank + link->span <= index) {
+            rank += link->span;
+            x = link->next;
+            link = skip_link_at(list, x, level);
+        }
+        update[level] = x;
+        ranks[level] = rank;
+    }
+    //finish the search on the node chain.
+    while (rank < index) {
+        x = (x == NULL) ? list->head : x->next;
+        rank++;
+    }
+    update[0] = x;
+    ranks[0] = rank;
+}
+
+//retrieve the node at an index within the bounds of an indexed list.
+static struct node* skip_get_node(struct linked_list* list, size_t index) {
+    struct node* x = NULL;
+    //position + 1 of the node to find.
+    size_t target = index + 1;
+    size_t rank = 0;
+
+    for (unsigned int level = list->skip_levels; level > 0; level--) {
+        struct skip_link* link = skip_link_at(list, x, level);
+        while (link->next != NULL && rank + link->span <= target) {
+            rank += link->span;
+            x = link->next;
+            link = skip_link_at(list, x, level);
+        }
+        if (rank == target) {
+            return x;
+        }
+    }
+    //finish the search on the node chain.
+    while (rank < target) {
+        x = (x == NULL) ? list->head : x->next;
+        rank++;
+    }
+    return x;
+}
+
+//link a node allocated with links for height levels into an indexed list at
+//index.
+static void skip_insert(struct linked_list* list, size_t index, struct node* node,
+                        unsigned int height) {
+    struct node* update[WC_SKIP_MAX_LEVELS + 1];
+    size_t ranks[WC_SKIP_MAX_LEVELS + 1];
+    skip_find_predecessors(list, index, update, ranks);
+    //bring the levels node is the first to take part in into use.
+    for (unsigned int level = list->skip_levels + 1; level <= height; level++) {
+        update[level] = NULL;
+        ranks[level] = 0;
+        list->skip_head[level - 1].next = NULL;
+        list->skip_head[level - 1].span = list->length;
+    }
+    if (height > list->skip_levels) {
+        list->skip_levels = height;
+    }
+    //splice node into the levels it takes part in.
+    for (unsigned int level = 1; level <= height; level++) {
+        struct skip_link* link = skip_link_at(list, update[level], level);
+        node->links[level - 1].next = link->next;
+        node->links[level - 1].span = link->span - (index - ranks[level]);
+        link->next = node;
+        link->span = index - ranks[level] + 1;
+    }
+    //links passing over node on the levels above now move one further.
+    for (unsigned int level = height + 1; level <= list->skip_levels; level++) {
+        skip_link_at(list, update[level], level)->span++;
+    }
+    node_link_after(list, update[0], node);
+}
+
+//work out how many skip list levels node takes part in, while walking the node
+//chain in order. level_previous holds the last node visited on each level in
+//use. (NULL for the list head).
+static unsigned int skip_height_of(struct linked_list* list, struct node** level_previous,
+                                   struct node* node) {
+    unsigned int height = 0;
+    while (height < list->skip_levels &&
+           skip_link_at(list, level_previous[height + 1], height + 1)->next == node) {
+        height++;
+    }
+    return height;
+}
+
+//stop using the levels at the top that no longer have any nodes.
+static void skip_trim_levels(struct linked_list* list) {
+    while (list->skip_levels > 0 && list->skip_head[list->skip_levels - 1].next == NULL) {
+        list->skip_levels--;
+    }
+}
+
+//unlink the node at an index within the bounds of an indexed list, and return
+//it.
+static struct node* skip_remove(struct linked_list* list, size_t index) {
+    struct node* update[WC_SKIP_MAX_LEVELS + 1];
+    size_t ranks[WC_SKIP_MAX_LEVELS + 1];
+    skip_find_predecessors(list, index, update, ranks);
+    struct node* node = (update[0] == NULL) ? list->head : update[0]->next;
+
+    for (unsigned int level = 1; level <= list->skip_levels; level++) {
+        struct skip_link* link = skip_link_at(list, update[level], level);
+        //jump over node on the levels it takes part in.
+        if (link->next == node) {
+            link->span += node->links[level - 1].span - 1;
+            link->next = node->links[level - 1].next;
+        //otherwise the link passes over one less node.
+        } else {
+            link->span--;
+        }
+    }
+    node_unlink_after(list, update[0], node);
+    skip_trim_levels(list);
+    return node;
+}
+
 //one if the elements are equal, 0 otherwise.
 static unsigned char is_element_equal(char* value_one, size_t value_one_length,
                                       char* value_two, size_t value_two_length) {
@@ -173,18 +811,45 @@ static unsigned char is_floating_point_element_equal(double* value_one, double*
     return (fabs(*value_one - *value_two) < epsilon);
 }
 
+//one if value is equal to an element of a list under the equality rules of
+//list_type, 0 otherwise.
+static unsigned char is_value_equal(enum linked_list_type list_type, void* element,
+                                    size_t element_length, void* value, size_t obj_length) {
+    //handle equality for floating point numbers.
+    if (list_type == WC_LINKEDLIST_DOUBLE) {
+        return is_floating_point_element_equal(element, value);
+    }
+    return is_element_equal(value, obj_length, element, element_length);
+}
+
+//one if value matches an element of list: through the equality callback of
+//the list when it has one, under the rules of its type otherwise.
+static unsigned char is_list_value_equal(struct linked_list* list, void* element,
+                                         size_t element_length, void* value, size_t obj_length) {
+    if (list->eq_fn != NULL) {
+        return list->eq_fn(value, obj_length, element, element_length, list->ops_ctx);
+    }
+    return is_value_equal(list->e_type, element, element_length, value, obj_length);
+}
+
 //retrieve the node at an index in the list will return NULL on failure.
 static struct node* linked_list_get_node(struct linked_list* list, size_t index) {
     //make sure the list exists.
     if (list == NULL) {
-        fputs("Error, attempting to retrieve a node from a NULL linked list.\n", stderr);
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST,
+                  "Error, attempting to retrieve a node from a NULL linked list.\n");
         return NULL;
     }
     //make sure that the index is within the bounds of the list.
-    if (index > list->length) {
-        fputs("Error. Attempting to get element from an index out of bounds.\n", stderr);
+    if (index >= list->length) {
+        set_error(WC_LINKEDLIST_ERROR_OUT_OF_BOUNDS,
+                  "Error. Attempting to get element from an index out of bounds.\n");
         return NULL;
     }
+    //indexed lists find the node in O(log n).
+    if (list->skip_head != NULL) {
+        return skip_get_node(list, index);
+    }
     //retrieve head of list for iteration
     struct node* list_iterator = list->head;
     //jump to the node at the index specified.
@@ -195,25 +860,27 @@ static struct node* linked_list_get_node(struct linked_list* list, size_t index)
 }
 
 //Returns 1 when a value is successfully found. previous will be set to the node
-//previous to the node found to be equal. This is useful for the
-//linked_list_remove_value function.
+//previous to the node found to be equal, and index (if not NULL) to the index
+//of the node found. This is useful for the linked_list_remove_value function.
 static unsigned char linked_list_find_value(struct linked_list* list, void* value, 
-                                            size_t obj_length, struct node** previous) {
+                                            size_t obj_length, struct node** previous,
+                                            size_t* index) {
     //make sure list exists.
     if (list == NULL) { 
-        fputs("Error. Attempting to remove a value from a NULL list.\n", stderr);
-        return 0;
-    }
-    //save head to make sure list itself doesn't lose it's head.
-    struct node* current = list->head;
-    //make sure that the list isn't empty.
-    if (current == NULL) { 
-        fputs("Error. Attempting to remove values from an empty list.", stderr);
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST,
+                  "Error. Attempting to remove a value from a NULL list.\n");
         return 0;
     }
     //make sure not attempting to remove a NULL value from the list.
     if (value == NULL) {
-        fputs("Error. Attempting to remove a NULL value from the list.\n", stderr);
+        set_error(WC_LINKEDLIST_ERROR_NULL_VALUE,
+                  "Error. Attempting to remove a NULL value from the list.\n");
+        return 0;
+    }
+    //save head to make sure list itself doesn't lose it's head.
+    struct node* current = list->head;
+    //an empty list holds no value. (a normal miss, not an error).
+    if (current == NULL) {
         return 0;
     }
     //make sure that previous is not NULL If it is NULL previous will not be
@@ -223,21 +890,29 @@ static unsigned char linked_list_find_value(struct linked_list* list, void* valu
         *previous = NULL;
     }
     //retrieve length of list.
-    int list_length = list->length;
-    //retrieve type of list.
-    enum linked_list_type list_type = list->e_type;
-    //look through all of the elements in the list.
-    for (int i = 0; i < list_length; i++) {
-        //check for an element in the list equal to the value passed.
-        unsigned char equal;
-        //handle equality for floating point numbers.
-        if (list_type == WC_LINKEDLIST_DOUBLE) {
-            equal = is_floating_point_element_equal(current->value, value);
-        } else {
-            equal = is_element_equal(value, obj_length, current->value, current->value_length);
+    size_t list_length = list->length;
+    //interned lists hold equal strings in the same buffer, so they can be
+    //compared by pointer; a string that isn't interned isn't in the list.
+    void* interned = NULL;
+    if (list->intern != NULL) {
+        struct intern_entry* entry = intern_lookup(list->intern, hash_bytes(value, obj_length),
+                                                   value, obj_length);
+        if (entry == NULL) {
+            return 0;
         }
+        interned = entry->data;
+    }
+    //look through all of the elements in the list.
+    for (size_t i = 0; i < list_length; i++) {
+        //start loading the next node while comparing the current one.
+        WC_PREFETCH(current->next);
         //Found an element in the list equal to the value passed.
-        if (equal) {
+        if ((interned != NULL) ? (current->value == interned)
+                               : is_list_value_equal(list, current->value,
+                                                     current->value_length, value, obj_length)) {
+            if (index != NULL) {
+                *index = i;
+            }
             return 1;
         }
         //move over one in the list only using previous if a valid previous
@@ -255,98 +930,568 @@ static unsigned char linked_list_find_value(struct linked_list* list, void* valu
 * Public Functions
 */
 
-//free a linked list from memory.
-void linked_list_free(struct linked_list* list_to_free) {
-    if (list_to_free == NULL) { 
-        fputs("Error. Attempting to free null linked list.\n", stderr);
-        return;
-    }
-    struct node* list_head = list_to_free->head;
-    size_t list_size = list_to_free->length;
-    //free every node in the list.
-    struct node* temp_node;
-    
-    for (size_t i = 0; i < list_size; i++) {
+//free up to max nodes from the front of a list. returns how many were freed.
+static size_t list_free_nodes(struct linked_list* list, size_t max) {
+    struct node* list_head = list->head;
+    size_t freed = 0;
+
+    while (list_head != NULL && freed < max) {
         //save the next one in the list so it can be freed next.
-        temp_node = list_head->next;
+        struct node* temp_node = list_head->next;
+        //start loading it while the current one is freed.
+        WC_PREFETCH(temp_node);
         //free the current one.
-        node_free(list_head);
+        node_free(list, list_head);
         //move on to the next node.
         list_head = temp_node;
+        freed++;
     }
-    //free the list itself after all nodes freed.
-    free(list_to_free);
-}
-
-//create a new empty linked list.
-struct linked_list* linked_list_new(enum linked_list_type type) {
-    //allocate memory required for a new list
-    struct linked_list* new_list = malloc(sizeof(struct linked_list));
-    //make sure that the list allocation was successful.
-    if (new_list == NULL) {
-        fputs("Error. Allocation of a new Linked List failed. System may be out of memory.\n", stderr);
-        return NULL;
+    list->head = list_head;
+    list->length -= freed;
+    if (list_head == NULL) {
+        list->tail = NULL;
     }
-    //set list properties to default values
-    new_list->head = NULL;
-    new_list->tail = NULL;
-    new_list->length = 0;
-    new_list->e_type = type;
-    return new_list;
+    return freed;
 }
 
-//add a new element to the list.
-unsigned char linked_list_add(struct linked_list* list, void* value, size_t obj_length) {
-    //make sure the passed list exists.
-    if (list == NULL) { 
-        fputs("Error. attempting to add an element to a NULL Linked List\n", stderr);
-        //return that the addition failed.
-        return 0;
-    }
-    //make sure a null value is not being added to the list.
-    if (value == NULL) {
-        fputs("Error. attempting to add a NULL element to a list.\n", stderr);
-        //return that the addition failed.
-        return 0;
+//free what is left of a list once all of its nodes are freed.
+static void list_free_shell(struct linked_list* list) {
+    //free the skip list head of an indexed list.
+    if (list->skip_head != NULL) {
+        list_dealloc(list, list->skip_head);
     }
-    //create a new node to add to the list.
-    struct node* new_node = malloc(sizeof(struct node));
-    //allocate a new container for the original value passed.
-    void* new_value = allocate_element(value, obj_length);
-    //make sure that allocation was successful.
-    if (new_value == NULL) {
-        fputs("Error. System out of memory, allocating a new element failed.\n", stderr);
-        return 0;
+    //free the private intern table of the list.
+    if (list->owns_intern) {
+        linked_list_intern_table_free(list->intern);
     }
-    new_node->value = new_value;
-    //set the length of the element stored into the node.
-    new_node->value_length = obj_length;
-    //this will be the last node in the list.
-    new_node->next = NULL;
-    //list is empty
-    if (list->head == NULL) {
-        //set head to the new created list node.
-        list->head = new_node;
-        //set the tail to the new head
-        list->tail = new_node;
-    //list has at least one element
-    } else {
-        //make a copy of the list tail
-        //to make sure not null
-        struct node* list_tail = list->tail;
-        //make sure the tail exists before attempting to dereference tail->next
-        if (list_tail == NULL) {
-            fputs("Error. the tail of the list is NULL.\n", stderr);
-        }
-        //set the new tail of the list
-        list_tail->next = new_node;
-        //update the tail node
-        list->tail = list_tail->next;
-    }
-    //add one to the list length, as an element has been added.
-    list->length++;
-    //return that the addition was successful.
-    return 1;    
+    //free the list itself after all nodes freed.
+    list_dealloc(list, list);
+}
+
+//one if a list can only be freed on the calling thread, or doesn't need
+//walking to be freed, 0 otherwise.
+static unsigned char list_frees_at_once(struct linked_list* list) {
+    //a region allocator can release everything the list allocated at once.
+    //(unless the list holds references into a shared intern table).
+    return list->allocator->reset != NULL &&
+           (list->intern == NULL || list->owns_intern);
+}
+
+//free a linked list from memory.
+void linked_list_free(struct linked_list* list_to_free) {
+    if (list_to_free == NULL) { 
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST,
+                  "Error. Attempting to free null linked list.\n");
+        return;
+    }
+    if (list_frees_at_once(list_to_free)) {
+        list_to_free->allocator->reset(list_to_free->allocator_ctx);
+        return;
+    }
+    //free every node in the list.
+    list_free_nodes(list_to_free, list_to_free->length);
+    list_free_shell(list_to_free);
+}
+
+/*
+* Background reclaimer
+*/
+
+//guards every reclaimer variable below.
+static pthread_mutex_t reclaimer_lock = PTHREAD_MUTEX_INITIALIZER;
+//signalled when a list is queued.
+static pthread_cond_t reclaimer_work = PTHREAD_COND_INITIALIZER;
+//signalled when the queue is empty and nothing is being freed.
+static pthread_cond_t reclaimer_idle = PTHREAD_COND_INITIALIZER;
+//lists waiting to be freed, oldest first.
+static struct linked_list* reclaimer_queue_head = NULL;
+static struct linked_list* reclaimer_queue_tail = NULL;
+//1 while the reclaimer is freeing a list taken off the queue.
+static unsigned char reclaimer_busy = 0;
+//microseconds the reclaimer sleeps between batches.
+static unsigned int reclaimer_delay = 0;
+//1 once the reclaimer thread has been started. (set under reclaimer_lock).
+static unsigned char reclaimer_started = 0;
+static pthread_once_t reclaimer_once = PTHREAD_ONCE_INIT;
+
+//reclaimer thread: free queued lists in batches, sleeping between batches
+//when throttled.
+static void* reclaimer_main(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&reclaimer_lock);
+    for (;;) {
+        while (reclaimer_queue_head == NULL) {
+            reclaimer_busy = 0;
+            pthread_cond_broadcast(&reclaimer_idle);
+            pthread_cond_wait(&reclaimer_work, &reclaimer_lock);
+        }
+        struct linked_list* list = reclaimer_queue_head;
+        reclaimer_queue_head = list->reclaim_next;
+        if (reclaimer_queue_head == NULL) {
+            reclaimer_queue_tail = NULL;
+        }
+        reclaimer_busy = 1;
+        pthread_mutex_unlock(&reclaimer_lock);
+
+        while (list_free_nodes(list, WC_RECLAIM_BATCH) == WC_RECLAIM_BATCH) {
+            pthread_mutex_lock(&reclaimer_lock);
+            unsigned int delay = reclaimer_delay;
+            pthread_mutex_unlock(&reclaimer_lock);
+            if (delay > 0) {
+                struct timespec pause;
+                pause.tv_sec = delay / 1000000;
+                pause.tv_nsec = (long)(delay % 1000000) * 1000;
+                nanosleep(&pause, NULL);
+            }
+        }
+        list_free_shell(list);
+        pthread_mutex_lock(&reclaimer_lock);
+    }
+    return NULL;
+}
+
+//start the detached reclaimer thread. (called once).
+static void reclaimer_start(void) {
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, reclaimer_main, NULL) == 0) {
+        pthread_detach(thread);
+        pthread_mutex_lock(&reclaimer_lock);
+        reclaimer_started = 1;
+        pthread_mutex_unlock(&reclaimer_lock);
+    }
+}
+
+//hand a list over to the background reclaimer.
+void linked_list_free_async(struct linked_list* list_to_free) {
+    if (list_to_free == NULL) { 
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST,
+                  "Error. Attempting to free null linked list.\n");
+        return;
+    }
+    //lists freed in one step gain nothing from the reclaimer, and shared
+    //intern tables may not be touched from another thread.
+    if (list_frees_at_once(list_to_free) ||
+        (list_to_free->intern != NULL && !list_to_free->owns_intern)) {
+        linked_list_free(list_to_free);
+        return;
+    }
+    pthread_once(&reclaimer_once, reclaimer_start);
+    list_to_free->reclaim_next = NULL;
+    pthread_mutex_lock(&reclaimer_lock);
+    //without a reclaimer thread the list is freed on the calling thread.
+    if (!reclaimer_started) {
+        pthread_mutex_unlock(&reclaimer_lock);
+        set_error(WC_LINKEDLIST_ERROR_INVALID_STATE,
+                  "Error. Unable to start the reclaimer thread, freeing the list in place.\n");
+        linked_list_free(list_to_free);
+        return;
+    }
+    if (reclaimer_queue_tail == NULL) {
+        reclaimer_queue_head = list_to_free;
+    } else {
+        reclaimer_queue_tail->reclaim_next = list_to_free;
+    }
+    reclaimer_queue_tail = list_to_free;
+    pthread_cond_signal(&reclaimer_work);
+    pthread_mutex_unlock(&reclaimer_lock);
+}
+
+//wait until every list handed to the reclaimer has been freed.
+void linked_list_reclaimer_drain(void) {
+    pthread_mutex_lock(&reclaimer_lock);
+    while (reclaimer_started && (reclaimer_queue_head != NULL || reclaimer_busy)) {
+        pthread_cond_wait(&reclaimer_idle, &reclaimer_lock);
+    }
+    pthread_mutex_unlock(&reclaimer_lock);
+}
+
+//set how long the reclaimer sleeps between batches of freed nodes.
+void linked_list_reclaimer_set_delay(unsigned int microseconds) {
+    pthread_mutex_lock(&reclaimer_lock);
+    reclaimer_delay = microseconds;
+    pthread_mutex_unlock(&reclaimer_lock);
+}
+
+//create a new empty linked list.
+struct linked_list* linked_list_new(enum linked_list_type type) {
+    return linked_list_new_with_allocator(type, &default_allocator, NULL);
+}
+
+//create a new empty linked list that allocates through the allocator passed.
+struct linked_list* linked_list_new_with_allocator(enum linked_list_type type,
+                                                   const struct wc_allocator* allocator,
+                                                   void* ctx) {
+    //make sure the allocator has all of the required hooks.
+    if (allocator == NULL || allocator->alloc == NULL ||
+        allocator->realloc == NULL || allocator->free == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_ARGUMENT,
+                  "Error. Attempting to create a Linked List with an incomplete allocator.\n");
+        return NULL;
+    }
+    //allocate memory required for a new list
+    struct linked_list* new_list = allocator->alloc(sizeof(struct linked_list), ctx);
+    //make sure that the list allocation was successful.
+    if (new_list == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_OUT_OF_MEMORY,
+                  "Error. Allocation of a new Linked List failed. System may be out of memory.\n");
+        return NULL;
+    }
+    //set list properties to default values
+    new_list->head = NULL;
+    new_list->tail = NULL;
+    new_list->length = 0;
+    new_list->e_type = type;
+    new_list->allocator = allocator;
+    new_list->allocator_ctx = ctx;
+    new_list->skip_head = NULL;
+    new_list->skip_levels = 0;
+    new_list->skip_rng = 0;
+    new_list->intern = NULL;
+    new_list->owns_intern = 0;
+    new_list->arena = NULL;
+    new_list->eq_fn = NULL;
+    new_list->hash_fn = NULL;
+    new_list->ops_ctx = NULL;
+    new_list->reclaim_next = NULL;
+    return new_list;
+}
+
+//create a new empty linked list comparing its elements through eq_fn.
+struct linked_list* linked_list_new_with_ops(enum linked_list_type type, linked_list_eq_fn eq_fn,
+                                             linked_list_hash_fn hash_fn, void* ctx) {
+    if (eq_fn == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_ARGUMENT,
+                  "Error. Attempting to create a Linked List with a NULL equality function.\n");
+        return NULL;
+    }
+    struct linked_list* new_list = linked_list_new(type);
+    if (new_list == NULL) {
+        return NULL;
+    }
+    linked_list_set_ops(new_list, eq_fn, hash_fn, ctx);
+    return new_list;
+}
+
+//compare the elements of an empty list through eq_fn from now on.
+unsigned char linked_list_set_ops(struct linked_list* list, linked_list_eq_fn eq_fn,
+                                  linked_list_hash_fn hash_fn, void* ctx) {
+    //make sure the list exists.
+    if (list == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST,
+                  "Error. Attempting to set the equality function of a NULL list.\n");
+        return 0;
+    }
+    if (eq_fn == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_ARGUMENT,
+                  "Error. Attempting to set a NULL equality function.\n");
+        return 0;
+    }
+    //existing elements were compared under the old rules, and interned
+    //values are compared by pointer rather than by a custom equality.
+    if (list->head != NULL || list->intern != NULL) {
+        set_error(WC_LINKEDLIST_ERROR_INVALID_STATE,
+                  "Error. Attempting to set the equality function of a list already in use.\n");
+        return 0;
+    }
+    list->eq_fn = eq_fn;
+    list->hash_fn = hash_fn;
+    list->ops_ctx = ctx;
+    return 1;
+}
+
+//thread the nodes of a list into an indexable skip list, so that positional
+//operations take O(log n).
+unsigned char linked_list_enable_index(struct linked_list* list) {
+    //make sure the list exists.
+    if (list == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST,
+                  "Error. Attempting to index a NULL list.\n");
+        return 0;
+    }
+    //list is already indexed.
+    if (list->skip_head != NULL) {
+        return 1;
+    }
+    struct skip_link* skip_head = list_alloc(list, WC_SKIP_MAX_LEVELS * sizeof(struct skip_link));
+    if (skip_head == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_OUT_OF_MEMORY,
+                  "Error. System out of memory, allocating a list index failed.\n");
+        return 0;
+    }
+    //seed the generator picking node heights. (a fixed seed still gives a
+    //working index if libsodium cannot be initialized).
+    list->skip_rng = 0x9E3779B97F4A7C15ULL;
+    if (sodium_init() >= 0) {
+        list->skip_rng ^= ((uint64_t)randombytes_random() << 32) | randombytes_random();
+    }
+    list->skip_head = skip_head;
+    list->skip_levels = 0;
+    //last node on each level so far, and its position + 1.
+    struct node* level_last[WC_SKIP_MAX_LEVELS + 1];
+    size_t level_last_rank[WC_SKIP_MAX_LEVELS + 1];
+    for (unsigned int level = 1; level <= WC_SKIP_MAX_LEVELS; level++) {
+        level_last[level] = NULL;
+        level_last_rank[level] = 0;
+    }
+    //append every existing node to the skip list levels in order.
+    struct node* previous = NULL;
+    struct node* current = list->head;
+    size_t rank = 0;
+
+    while (current != NULL) {
+        rank++;
+        struct node* next = current->next;
+        unsigned int height = skip_random_height(list);
+        //nodes taking part in skip list levels need room for their links.
+        //when that allocation fails the node simply stays on the node chain.
+        if (height > 0) {
+            struct node* linked_node = list_alloc(list, node_size(height));
+            if (linked_node == NULL) {
+                height = 0;
+            } else {
+                linked_node->value = current->value;
+                linked_node->value_length = current->value_length;
+                linked_node->next = next;
+                if (previous == NULL) {
+                    list->head = linked_node;
+                } else {
+                    previous->next = linked_node;
+                }
+                if (list->tail == current) {
+                    list->tail = linked_node;
+                }
+                list_release(list, current);
+                current = linked_node;
+            }
+        }
+        for (unsigned int level = 1; level <= height; level++) {
+            struct skip_link* link = skip_link_at(list, level_last[level], level);
+            link->next = current;
+            link->span = rank - level_last_rank[level];
+            level_last[level] = current;
+            level_last_rank[level] = rank;
+        }
+        if (height > list->skip_levels) {
+            list->skip_levels = height;
+        }
+        previous = current;
+        current = next;
+    }
+    //close off every level in use.
+    for (unsigned int level = 1; level <= list->skip_levels; level++) {
+        struct skip_link* link = skip_link_at(list, level_last[level], level);
+        link->next = NULL;
+        link->span = list->length - level_last_rank[level];
+    }
+    return 1;
+}
+
+//intern the string values of a list.
+unsigned char linked_list_enable_interning(struct linked_list* list,
+                                           struct linked_list_intern_table* table) {
+    //make sure the list exists.
+    if (list == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST,
+                  "Error. Attempting to intern the values of a NULL list.\n");
+        return 0;
+    }
+    //only strings are interned.
+    if (list->e_type != WC_LINKEDLIST_STRING) {
+        set_error(WC_LINKEDLIST_ERROR_TYPE_MISMATCH,
+                  "Error. Attempting to intern the values of a list that isn't a string list.\n");
+        return 0;
+    }
+    //existing values would have been allocated differently, and interned
+    //values are compared by pointer rather than by a custom equality.
+    if (list->head != NULL || list->intern != NULL || list->eq_fn != NULL) {
+        set_error(WC_LINKEDLIST_ERROR_INVALID_STATE,
+                  "Error. Attempting to intern the values of a list already in use.\n");
+        return 0;
+    }
+    //lists without a shared table get a private one.
+    if (table == NULL) {
+        table = intern_table_create(list->allocator, list->allocator_ctx);
+        if (table == NULL) {
+            return 0;
+        }
+        list->owns_intern = 1;
+    }
+    list->intern = table;
+    return 1;
+}
+
+//round size up so that whatever follows it in an arena is aligned.
+static size_t arena_round(size_t size) {
+    size_t alignment = _Alignof(max_align_t);
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+//copy the nodes and values of a list into one block of memory, in list order.
+unsigned char linked_list_compact(struct linked_list* list) {
+    //make sure the list exists.
+    if (list == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST,
+                  "Error. Attempting to compact a NULL list.\n");
+        return 0;
+    }
+    //nothing to move.
+    if (list->head == NULL) {
+        return 1;
+    }
+    //last node visited on each skip list level. (for working out the height
+    //of each node of an indexed list).
+    struct node* level_previous[WC_SKIP_MAX_LEVELS + 1];
+    for (unsigned int level = 1; level <= list->skip_levels; level++) {
+        level_previous[level] = NULL;
+    }
+    //add up the memory every node and value takes up.
+    size_t arena_size = 0;
+    size_t allocations = 0;
+    for (struct node* current = list->head; current != NULL; current = current->next) {
+        unsigned int height = skip_height_of(list, level_previous, current);
+        for (unsigned int level = 1; level <= height; level++) {
+            level_previous[level] = current;
+        }
+        arena_size += arena_round(node_size(height));
+        allocations++;
+        //interned values stay in their intern table.
+        if (list->intern == NULL) {
+            arena_size += arena_round(current->value_length);
+            allocations++;
+        }
+    }
+    struct node_arena* arena = list_alloc(list, sizeof(struct node_arena) + arena_size);
+    if (arena == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_OUT_OF_MEMORY,
+                  "Error. System out of memory, allocating a compacted list failed.\n");
+        return 0;
+    }
+    arena->live = allocations;
+    arena->size = arena_size;
+    //copy each node followed by its value into the arena, relinking the copies
+    //as they are made. the old nodes are left untouched until the end.
+    unsigned char* next_free = (unsigned char*)arena->storage;
+    struct node* new_level_previous[WC_SKIP_MAX_LEVELS + 1];
+    for (unsigned int level = 1; level <= list->skip_levels; level++) {
+        level_previous[level] = NULL;
+        new_level_previous[level] = NULL;
+    }
+    struct node* old_head = list->head;
+    struct node* new_previous = NULL;
+
+    for (struct node* current = old_head; current != NULL; current = current->next) {
+        WC_PREFETCH(current->next);
+        unsigned int height = skip_height_of(list, level_previous, current);
+        struct node* new_node = (struct node*)next_free;
+        memcpy(new_node, current, node_size(height));
+        next_free += arena_round(node_size(height));
+        if (list->intern == NULL) {
+            memcpy(next_free, current->value, current->value_length);
+            new_node->value = next_free;
+            next_free += arena_round(current->value_length);
+        }
+        //point the previous copy on every level at the new copy.
+        for (unsigned int level = 1; level <= height; level++) {
+            skip_link_at(list, new_level_previous[level], level)->next = new_node;
+            level_previous[level] = current;
+            new_level_previous[level] = new_node;
+        }
+        if (new_previous == NULL) {
+            list->head = new_node;
+        } else {
+            new_previous->next = new_node;
+        }
+        new_previous = new_node;
+    }
+    list->tail = new_previous;
+    //free the old nodes and values. (an old arena is freed as a whole).
+    struct node_arena* old_arena = list->arena;
+    list->arena = NULL;
+    struct node* current = old_head;
+    while (current != NULL) {
+        struct node* next = current->next;
+        WC_PREFETCH(next);
+        if (list->intern == NULL &&
+            (old_arena == NULL || !arena_contains(old_arena, current->value))) {
+            list_dealloc(list, current->value);
+        }
+        if (old_arena == NULL || !arena_contains(old_arena, current)) {
+            list_dealloc(list, current);
+        }
+        current = next;
+    }
+    if (old_arena != NULL) {
+        list_dealloc(list, old_arena);
+    }
+    list->arena = arena;
+    return 1;
+}
+
+//add a new element to the list.
+unsigned char linked_list_add(struct linked_list* list, void* value, size_t obj_length) {
+    //make sure the passed list exists.
+    if (list == NULL) { 
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST,
+                  "Error. attempting to add an element to a NULL Linked List\n");
+        //return that the addition failed.
+        return 0;
+    }
+    //adding is inserting after the last element.
+    return linked_list_insert_at(list, list->length, value, obj_length);
+}
+
+//insert a new element into the list so that it is at index.
+unsigned char linked_list_insert_at(struct linked_list* list, size_t index, void* value,
+                                    size_t obj_length) {
+    //make sure the passed list exists.
+    if (list == NULL) { 
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST,
+                  "Error. attempting to add an element to a NULL Linked List\n");
+        return 0;
+    }
+    //make sure a null value is not being added to the list.
+    if (value == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_VALUE,
+                  "Error. attempting to add a NULL element to a list.\n");
+        return 0;
+    }
+    //index may be one past the last element. (appending).
+    if (index > list->length) {
+        set_error(WC_LINKEDLIST_ERROR_OUT_OF_BOUNDS,
+                  "Error. Attempting to insert at an index out of bounds.\n");
+        return 0;
+    }
+    //indexed lists splice the node into the skip list levels as well.
+    if (list->skip_head != NULL) {
+        unsigned int height = skip_random_height(list);
+        struct node* new_node = node_new(list, value, obj_length, height);
+        if (new_node == NULL) {
+            return 0;
+        }
+        skip_insert(list, index, new_node, height);
+        return 1;
+    }
+    //find the element the new one goes after. appending uses the tail, so
+    //that adding to the end of a list doesn't walk it.
+    struct node* previous = NULL;
+    if (index == list->length && index > 0) {
+        previous = list->tail;
+    } else if (index > 0) {
+        previous = linked_list_get_node(list, index - 1);
+    }
+    //make sure the node found exists before linking after it.
+    if (index > 0 && previous == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_INVALID_STATE,
+                  "Error. the tail of the list is NULL.\n");
+        return 0;
+    }
+    struct node* new_node = node_new(list, value, obj_length, 0);
+    if (new_node == NULL) {
+        return 0;
+    }
+    node_link_after(list, previous, new_node);
+    //return that the addition was successful.
+    return 1;    
 }
 
 //Get the value at the passed index of the list returns NULL on failure. Item
@@ -377,10 +1522,35 @@ unsigned char linked_list_set(struct linked_list* list, size_t index, void* valu
     if (list_element_to_modify == NULL) {
         return 0;
     }
+    //interned lists swap the node's reference for one to the new value.
+    if (list->intern != NULL) {
+        void* interned = intern_acquire(list->intern, value, obj_length);
+        if (interned == NULL) {
+            set_error(WC_LINKEDLIST_ERROR_OUT_OF_MEMORY,
+                      "Error. System out of memory, allocating a new element failed.\n");
+            return 0;
+        }
+        intern_release(list->intern, list_element_to_modify->value);
+        list_element_to_modify->value = interned;
+        list_element_to_modify->value_length = obj_length;
+        return 1;
+    }
     //make a copy of the element's value pointer to manipulate.
     void* list_element_value = list_element_to_modify->value;
-    //reallocate the value in the element to the right size
-    list_element_value = realloc(list_element_value, obj_length);
+    //values in the list's arena can't be resized in place; overwrite them
+    //when the new value fits, and move them out when it grows.
+    if (list->arena != NULL && arena_contains(list->arena, list_element_value)) {
+        if (obj_length > list_element_to_modify->value_length) {
+            list_element_value = list_alloc(list, obj_length);
+            if (list_element_value == NULL) {
+                return 0;
+            }
+            list_release(list, list_element_to_modify->value);
+        }
+    } else {
+        //reallocate the value in the element to the right size
+        list_element_value = list_realloc(list, list_element_value, obj_length);
+    }
     //if the memory reallocation fails don't modify the list, and return
     //unsuccessful.
     if (list_element_value == NULL) {
@@ -396,7 +1566,22 @@ unsigned char linked_list_set(struct linked_list* list, size_t index, void* valu
 //check whether the list contains a value returns 1 if the value exists in the
 //list. 0 when the value isn't there.
 unsigned char linked_list_contains(struct linked_list* list, void* value, size_t obj_length) {
-    return linked_list_find_value(list, value, obj_length, NULL);
+    return linked_list_find_value(list, value, obj_length, NULL, NULL);
+}
+
+//find the first element matching key, and return it in place through out.
+unsigned char linked_list_find(struct linked_list* list, void* key, size_t key_length,
+                               struct list_value* out) {
+    struct node* previous;
+    if (!linked_list_find_value(list, key, key_length, &previous, NULL)) {
+        return 0;
+    }
+    struct node* found = (previous == NULL) ? list->head : previous->next;
+    if (out != NULL) {
+        out->item_length = found->value_length;
+        out->item = found->value;
+    }
+    return 1;
 }
 
 //return the length of the list
@@ -408,19 +1593,52 @@ size_t linked_list_size(struct linked_list* list) {
     return list->length;
 }
 
+//create a new empty list set up like the list passed: same type and
+//allocator, indexed if it is, and interning into the same shared table (or a
+//private one of its own). will return NULL on failure.
+static struct linked_list* list_new_like(struct linked_list* list) {
+    //allocate the new list, using the same allocator as the original list.
+    //a resettable allocator context belongs to the list it was created with,
+    //freeing the new list would reset it, so the default allocator is used.
+    const struct wc_allocator* allocator = list->allocator;
+    void* ctx = list->allocator_ctx;
+    if (allocator->reset != NULL) {
+        allocator = &default_allocator;
+        ctx = NULL;
+    }
+    struct linked_list* new_list = linked_list_new_with_allocator(list->e_type, allocator, ctx);
+    if (new_list == NULL) {
+        return NULL;
+    }
+    new_list->eq_fn = list->eq_fn;
+    new_list->hash_fn = list->hash_fn;
+    new_list->ops_ctx = list->ops_ctx;
+    if (list->skip_head != NULL && !linked_list_enable_index(new_list)) {
+        linked_list_free(new_list);
+        return NULL;
+    }
+    if (list->intern != NULL &&
+        !linked_list_enable_interning(new_list, list->owns_intern ? NULL : list->intern)) {
+        linked_list_free(new_list);
+        return NULL;
+    }
+    return new_list;
+}
+
 //clone the list passed.
 struct linked_list* linked_list_clone(struct linked_list* list) {
     //make sure the list to clone exists.
     if (list == NULL) {
-        fputs("Error. Cannot clone a NULL list.\n", stderr);
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST, "Error. Cannot clone a NULL list.\n");
+        return NULL;
     }
-    //retrieve list type and length.
+    //retrieve list length.
     size_t list_length = list->length;
-    enum linked_list_type list_type = list->e_type;
-    //allocate the new list to populate
-    struct linked_list* new_list = linked_list_new(list_type);
-    //set the new list to have the same type as the original list.
-    new_list->e_type = list_type;
+    //allocate the new list to populate.
+    struct linked_list* new_list = list_new_like(list);
+    if (new_list == NULL) {
+        return NULL;
+    }
     //original list iterator
     struct node* original_list_current = list->head;
     //list is empty, returning the new empty list.
@@ -442,7 +1660,7 @@ struct linked_list* linked_list_clone(struct linked_list* list) {
 void linked_list_shuffle(struct linked_list* list) {
     //make sure that the list actually exists.
     if (list == NULL) {
-        fputs("Error. Cannot clone a NULL list.\n", stderr);
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST, "Error. Cannot shuffle a NULL list.\n");
         return;
     }
     //Initiate libsodium, and return on failure.
@@ -458,8 +1676,9 @@ void linked_list_shuffle(struct linked_list* list) {
         struct node* current_node = linked_list_get_node(list, i);
         //Make sure that get_node didn't have any issues.
         if (random_list_node == NULL || current_node == NULL) {
-            fputs("Error. Unable to retrieve within bounds nodes in "
-                  "linked_list_shuffle.\n", stderr);
+            set_error(WC_LINKEDLIST_ERROR_INVALID_STATE,
+                      "Error. Unable to retrieve within bounds nodes in "
+                      "linked_list_shuffle.\n");
             return;
         }
         //retrieve the value and length of the current node
@@ -476,93 +1695,188 @@ void linked_list_shuffle(struct linked_list* list) {
     }
 }
 
+//seed a fast generator.
+void linked_list_fast_rng_seed(struct linked_list_fast_rng* rng, uint64_t seed) {
+    if (rng == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_ARGUMENT,
+                  "Error. Attempting to seed a NULL generator.\n");
+        return;
+    }
+    //xorshift state must never be 0.
+    rng->state = (seed == 0) ? 0x9E3779B97F4A7C15ULL : seed;
+}
+
+//uniform function of the fast generator.
+uint32_t linked_list_fast_rng_uniform(uint32_t upper_bound, void* ctx) {
+    struct linked_list_fast_rng* rng = ctx;
+    if (upper_bound < 2) {
+        return 0;
+    }
+    //reject the values that would make the low end of the range more likely.
+    uint32_t min = (uint32_t)(-upper_bound) % upper_bound;
+    uint32_t random_value;
+    do {
+        random_value = (uint32_t)(xorshift64_star(&rng->state) >> 32);
+    } while (random_value < min);
+    return random_value % upper_bound;
+}
+
+//draw a random value in [0, upper_bound) from rng, or libsodium when rng is
+//NULL.
+static uint32_t rng_uniform(const struct linked_list_rng* rng, uint32_t upper_bound) {
+    if (rng == NULL) {
+        return randombytes_uniform(upper_bound);
+    }
+    return rng->uniform(upper_bound, rng->ctx);
+}
+
+//make sure a generator can be used. libsodium needs to be initialized when no
+//generator is passed. returns 1 when it can be used. 0 Otherwise.
+static unsigned char rng_ready(const struct linked_list_rng* rng) {
+    if (rng == NULL) {
+        return sodium_init() >= 0;
+    }
+    if (rng->uniform == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_ARGUMENT,
+                  "Error. Attempting to draw from a generator without a uniform function.\n");
+        return 0;
+    }
+    return 1;
+}
+
+//pick up to k random elements of the list in a single pass.
+size_t linked_list_sample(struct linked_list* list, size_t k, struct list_value out_values[],
+                          const struct linked_list_rng* rng) {
+    //make sure the list exists.
+    if (list == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST,
+                  "Error. Attempting to sample a NULL list.\n");
+        return 0;
+    }
+    if (out_values == NULL && k > 0) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_ARGUMENT,
+                  "Error. Attempting to sample into a NULL array.\n");
+        return 0;
+    }
+    if (!rng_ready(rng)) {
+        return 0;
+    }
+    size_t picked = 0;
+    size_t seen = 0;
+
+    for (struct node* current = list->head; current != NULL; current = current->next) {
+        //the first k elements fill the reservoir.
+        if (picked < k) {
+            out_values[picked].item_length = current->value_length;
+            out_values[picked].item = current->value;
+            picked++;
+        //afterwards element i replaces a random reservoir entry with a
+        //probability of k / (i + 1).
+        } else {
+            uint32_t slot = rng_uniform(rng, (uint32_t)(seen + 1));
+            if (slot < k) {
+                out_values[slot].item_length = current->value_length;
+                out_values[slot].item = current->value;
+            }
+        }
+        seen++;
+    }
+    return picked;
+}
+
+//pick a random element of the list.
+struct list_value linked_list_random_element(struct linked_list* list,
+                                             const struct linked_list_rng* rng) {
+    struct list_value value_to_return;
+    value_to_return.item_length = 0;
+    value_to_return.item = NULL;
+    //make sure the list exists and has an element to pick.
+    if (list == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST,
+                  "Error. Attempting to sample a NULL list.\n");
+        return value_to_return;
+    }
+    if (list->length == 0) {
+        set_error(WC_LINKEDLIST_ERROR_EMPTY_LIST,
+                  "Error. Attempting to sample an empty list.\n");
+        return value_to_return;
+    }
+    if (!rng_ready(rng)) {
+        return value_to_return;
+    }
+    //O(log n) on indexed lists, a walk to the index otherwise.
+    return linked_list_get(list, rng_uniform(rng, (uint32_t)list->length));
+}
+
 //remove an element from the list at an index
 unsigned char linked_list_remove_at(struct linked_list* list, size_t index) {
     //make sure list exists.
     if (list == NULL) { 
-        fputs("Error. Attempting to remove a value from a NULL list.\n", stderr);
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST,
+                  "Error. Attempting to remove a value from a NULL list.\n");
         return 0;
     }
-    //calculate the maximum value that the index can be.
-    size_t max_index_value = list->length - 1;
-    //make sure that the index is within the size of the list.
-    if (index > max_index_value) {
-        fputs("Error. Attempting to remove at an index out of bounds.\n", stderr);
+    //make sure that the list isn't empty.
+    if (list->head == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_EMPTY_LIST,
+                  "Error. Attempting to remove values from an empty list.\n");
         return 0;
     }
-    //copy list head for iteration.
-    struct node* list_head = list->head;
-    //make sure that the list isn't empty.
-    if (list_head == NULL) {
-        fputs("Error. Attempting to remove values from an empty list.", stderr);
+    //make sure that the index is within the size of the list.
+    if (index >= list->length) {
+        set_error(WC_LINKEDLIST_ERROR_OUT_OF_BOUNDS,
+                  "Error. Attempting to remove at an index out of bounds.\n");
         return 0;
     }
-    //handle removing from list with 1 element. It is implied that index is also
-    //0, because index cannot be less than 0; and index is less than or equal to
-    //max_index_value.
-    if (max_index_value == 0) {
-        //free only element in the list.
-        node_free(list_head);
-        list->head = NULL;
-    //Removing the first element in the list when the list has more than one
-    //element.
-    } else if (index == 0) {
-        //replace the head with the next element in the list.
-        list->head = list_head->next;
-        //free the head element.
-        node_free(list_head);
-    } else {
-        //index must be > 0 and <= max_index_value for code below this comment
-        //to execute. get the element before the one to be removed.
-        list_head = linked_list_get_node(list, index - 1);
+    //indexed lists unlink the node from the skip list levels as well.
+    if (list->skip_head != NULL) {
+        node_free(list, skip_remove(list, index));
+        return 1;
+    }
+    //get the element before the one to be removed. (NULL when removing the
+    //head of the list).
+    struct node* previous = NULL;
+    if (index > 0) {
+        previous = linked_list_get_node(list, index - 1);
         //get_node must have failed...
-        if (list_head == NULL) {
+        if (previous == NULL) {
             return 0;
         }
-        //now at the element infront of the one to remove.
-        struct node* node_to_free = list_head->next;
-        // make sure the node to free is not the tail of the list.
-		// If it is, set it to the element before it.
-		if (node_to_free == list->tail) {
-			list->tail = list_head;
-		}
-        //jump over the element to remove (removing it from the list).
-        list_head->next = node_to_free->next;
-        //free node that was removed.
-        node_free(node_to_free);
-    }
-    //decrement list length
-    list->length--;
+    }
+    struct node* node_to_free = (previous == NULL) ? list->head : previous->next;
+    //jump over the element to remove (removing it from the list).
+    node_unlink_after(list, previous, node_to_free);
+    //free node that was removed.
+    node_free(list, node_to_free);
     //return that the removal was successful.
     return 1;
 }
 
 //remove an element from the list using a value
 int linked_list_remove_value(struct linked_list* list, void* value, size_t obj_length) {
-    //previous node to the one containing the value: (if found)
+    //previous node to the one containing the value, and its index: (if found)
     struct node* previous;
+    size_t index;
+    //make sure that the list isn't empty.
+    if (list != NULL && list->head == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_EMPTY_LIST,
+                  "Error. Attempting to remove values from an empty list.\n");
+        return 0;
+    }
     //If an equal element is discovered, remove it.
-    if (linked_list_find_value(list, value, obj_length, &previous)) {
-        //equal to the first element in the list
-        if (previous == NULL) {
-            //make a copy of head, to free its value when it is skipped over.
-            struct node* temp = list->head;
-            //remove head from the list.
-            list->head = temp->next;
-            //free current.
-            node_free(temp);
-        //equality not at first element.
-        } else {
-            //get the node to remove from the list. we know it exists, otherwise
-            //linked_list_find_value would return 0.
-            struct node* current = previous->next;
-            //jump over current element.
-            previous->next = current->next;
-            //free the node to remove.
-            node_free(current);
-        }
-        //decrement list length.
-        list->length--;
+    if (linked_list_find_value(list, value, obj_length, &previous, &index)) {
+        //indexed lists unlink the node from the skip list levels as well.
+        if (list->skip_head != NULL) {
+            node_free(list, skip_remove(list, index));
+            return 1;
+        }
+        //get the node to remove from the list. we know it exists, otherwise
+        //linked_list_find_value would return 0.
+        struct node* current = (previous == NULL) ? list->head : previous->next;
+        //jump over current element.
+        node_unlink_after(list, previous, current);
+        //free the node to remove.
+        node_free(list, current);
         //return successful removal.
         return 1;            
     }
@@ -570,6 +1884,368 @@ int linked_list_remove_value(struct linked_list* list, void* value, size_t obj_l
     return 0;
 }
 
+//value to compare against for linked_list_remove_all_values.
+struct value_match {
+    struct linked_list* list;
+    void* value;
+    size_t obj_length;
+};
+
+//linked_list_predicate matching values equal to a struct value_match.
+static unsigned char is_matching_value(void* value, size_t value_length, void* ctx) {
+    struct value_match* match = ctx;
+    return is_list_value_equal(match->list, value, value_length, match->value,
+                               match->obj_length);
+}
+
+//linked_list_predicate matching the value stored at the address in ctx.
+static unsigned char is_same_value(void* value, size_t value_length, void* ctx) {
+    (void)value_length;
+    return value == ctx;
+}
+
+//remove every element equal to value from the list in a single pass.
+size_t linked_list_remove_all_values(struct linked_list* list, void* value, size_t obj_length) {
+    //make sure not attempting to remove a NULL value from the list.
+    if (value == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_VALUE,
+                  "Error. Attempting to remove a NULL value from the list.\n");
+        return 0;
+    }
+    //interned lists compare the shared buffer by pointer. a string that isn't
+    //interned isn't in the list.
+    if (list != NULL && list->intern != NULL) {
+        struct intern_entry* entry = intern_lookup(list->intern, hash_bytes(value, obj_length),
+                                                   value, obj_length);
+        if (entry == NULL) {
+            return 0;
+        }
+        return linked_list_remove_if(list, is_same_value, entry->data);
+    }
+    struct value_match match;
+    match.list = list;
+    match.value = value;
+    match.obj_length = obj_length;
+    return linked_list_remove_if(list, is_matching_value, &match);
+}
+
+//remove every element of the list that predicate returns 1 for in a single
+//pass.
+size_t linked_list_remove_if(struct linked_list* list, linked_list_predicate predicate, void* ctx) {
+    //make sure list exists.
+    if (list == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST,
+                  "Error. Attempting to remove values from a NULL list.\n");
+        return 0;
+    }
+    if (predicate == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_ARGUMENT,
+                  "Error. Attempting to remove values using a NULL predicate.\n");
+        return 0;
+    }
+    size_t removed = 0;
+    //last node kept in the list. (NULL while no node has been kept).
+    struct node* previous = NULL;
+    struct node* current = list->head;
+    //for indexed lists: the last node kept on each skip list level, and how
+    //many nodes its link on that level has lost and not yet accounted for.
+    struct node* level_previous[WC_SKIP_MAX_LEVELS + 1];
+    size_t level_removed[WC_SKIP_MAX_LEVELS + 1];
+    unsigned int levels = list->skip_levels;
+
+    for (unsigned int level = 1; level <= levels; level++) {
+        level_previous[level] = NULL;
+        level_removed[level] = 0;
+    }
+    while (current != NULL) {
+        struct node* next = current->next;
+        //start loading the next node while the predicate runs.
+        WC_PREFETCH(next);
+        //work out how many skip list levels current takes part in.
+        unsigned int height = skip_height_of(list, level_previous, current);
+        if (predicate(current->value, current->value_length, ctx)) {
+            //jump over the current element on every level it takes part in.
+            for (unsigned int level = 1; level <= height; level++) {
+                struct skip_link* link = skip_link_at(list, level_previous[level], level);
+                link->span += current->links[level - 1].span - 1 - level_removed[level];
+                link->next = current->links[level - 1].next;
+                level_removed[level] = 0;
+            }
+            //links on the levels above pass over one less node.
+            for (unsigned int level = height + 1; level <= levels; level++) {
+                level_removed[level]++;
+            }
+            //jump over the current element.
+            if (previous == NULL) {
+                list->head = next;
+            } else {
+                previous->next = next;
+            }
+            node_free(list, current);
+            removed++;
+        } else {
+            //current becomes the last node kept on its levels.
+            for (unsigned int level = 1; level <= height; level++) {
+                skip_link_at(list, level_previous[level], level)->span -= level_removed[level];
+                level_previous[level] = current;
+                level_removed[level] = 0;
+            }
+            previous = current;
+        }
+        current = next;
+    }
+    //account for the nodes removed after the last node kept on each level.
+    for (unsigned int level = 1; level <= levels; level++) {
+        skip_link_at(list, level_previous[level], level)->span -= level_removed[level];
+    }
+    //the last node kept is the new end of the list.
+    list->tail = previous;
+    list->length -= removed;
+    if (list->skip_head != NULL) {
+        skip_trim_levels(list);
+    }
+    return removed;
+}
+
+/*
+* Set operation functions
+*/
+
+//Slot of a value_set. (value is NULL for an empty slot).
+struct value_set_slot {
+    uint64_t hash;
+    void* value;
+    size_t value_length;
+};
+
+//Temporary hash set of list values used by the set operations. values are
+//referenced, not copied. sized up front, so it never grows. slots come from
+//the default allocator, so scratch sets never use up a caller's region.
+struct value_set {
+    struct value_set_slot* slots;
+    //number of slots. (a power of two).
+    size_t capacity;
+    //list whose equality rules the set uses.
+    struct linked_list* list;
+};
+
+//allocate a set with room for expected values, following the equality rules
+//of list. returns 1 on success. 0 Otherwise.
+static unsigned char value_set_init(struct value_set* set, struct linked_list* list,
+                                    size_t expected) {
+    //keep the set at most half full.
+    size_t capacity = 8;
+    while (capacity < expected * 2) {
+        capacity *= 2;
+    }
+    set->slots = default_alloc(capacity * sizeof(struct value_set_slot), NULL);
+    if (set->slots == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_OUT_OF_MEMORY,
+                  "Error. System out of memory, allocating a hash set failed.\n");
+        return 0;
+    }
+    memset(set->slots, 0, capacity * sizeof(struct value_set_slot));
+    set->capacity = capacity;
+    set->list = list;
+    return 1;
+}
+
+static void value_set_free(struct value_set* set) {
+    default_free(set->slots, NULL);
+}
+
+//work out the hashes a value equal to value may be stored under. returns how
+//many there are. doubles are hashed by which epsilon wide cell they fall in,
+//so a double within epsilon of value is under the hash of its cell or of one
+//of the two cells next to it.
+static size_t value_set_hashes(struct value_set* set, void* value, size_t obj_length,
+                               uint64_t hashes[3]) {
+    //lists with their own equality need their own hash. without one every
+    //value shares a hash, which is slow but still correct.
+    if (set->list->eq_fn != NULL) {
+        hashes[0] = (set->list->hash_fn == NULL) ? 0 :
+                    set->list->hash_fn(value, obj_length, set->list->ops_ctx);
+        return 1;
+    }
+    if (set->list->e_type != WC_LINKEDLIST_DOUBLE) {
+        hashes[0] = hash_bytes(value, obj_length);
+        return 1;
+    }
+    double number = *(double*)value;
+    //NaN and infinities are never equal to anything.
+    if (!isfinite(number)) {
+        hashes[0] = hash_bytes(value, sizeof(double));
+        return 1;
+    }
+    //adding 0.0 turns -0.0 into 0.0.
+    double cells[3];
+    cells[0] = floor(number / 0.00001) + 0.0;
+    cells[1] = cells[0] - 1.0;
+    cells[2] = cells[0] + 1.0;
+    for (size_t i = 0; i < 3; i++) {
+        hashes[i] = hash_bytes(&cells[i], sizeof(double));
+    }
+    return 3;
+}
+
+//find a value in the set equal to value. returns 1 when one is found.
+static unsigned char value_set_contains(struct value_set* set, void* value, size_t obj_length) {
+    uint64_t hashes[3];
+    size_t hash_count = value_set_hashes(set, value, obj_length, hashes);
+    for (size_t i = 0; i < hash_count; i++) {
+        size_t slot = hashes[i] & (set->capacity - 1);
+        //walk the run of used slots the value would be in.
+        while (set->slots[slot].value != NULL) {
+            struct value_set_slot* current = &set->slots[slot];
+            if (current->hash == hashes[i] &&
+                is_list_value_equal(set->list, current->value, current->value_length,
+                                    value, obj_length)) {
+                return 1;
+            }
+            slot = (slot + 1) & (set->capacity - 1);
+        }
+    }
+    return 0;
+}
+
+//add value to the set, even if an equal value is already in it. (double
+//equality isn't transitive, so a lookup set has to hold every value).
+static void value_set_insert(struct value_set* set, void* value, size_t obj_length) {
+    uint64_t hashes[3];
+    value_set_hashes(set, value, obj_length, hashes);
+    size_t slot = hashes[0] & (set->capacity - 1);
+    while (set->slots[slot].value != NULL) {
+        slot = (slot + 1) & (set->capacity - 1);
+    }
+    set->slots[slot].hash = hashes[0];
+    set->slots[slot].value = value;
+    set->slots[slot].value_length = obj_length;
+}
+
+//add value to the set, unless an equal value is already in it. returns 1 when
+//value was added.
+static unsigned char value_set_add(struct value_set* set, void* value, size_t obj_length) {
+    if (value_set_contains(set, value, obj_length)) {
+        return 0;
+    }
+    value_set_insert(set, value, obj_length);
+    return 1;
+}
+
+//linked_list_predicate matching values already seen. (ctx is a value_set).
+static unsigned char is_duplicate_value(void* value, size_t value_length, void* ctx) {
+    return !value_set_add(ctx, value, value_length);
+}
+
+//remove every element equal to an element before it.
+size_t linked_list_unique(struct linked_list* list) {
+    if (list == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST,
+                  "Error. Attempting to remove duplicates from a NULL list.\n");
+        return 0;
+    }
+    struct value_set seen;
+    if (!value_set_init(&seen, list, list->length)) {
+        return 0;
+    }
+    //the nodes of duplicates are unlinked and freed; the rest stay in place.
+    size_t removed = linked_list_remove_if(list, is_duplicate_value, &seen);
+    value_set_free(&seen);
+    return removed;
+}
+
+//Kinds of set operation.
+enum set_operation {
+    SET_INTERSECT, SET_DIFFERENCE, SET_UNION
+};
+
+//build a new list like a, holding the distinct values picked from a and b by
+//operation.
+static struct linked_list* set_combine(struct linked_list* a, struct linked_list* b,
+                                       enum set_operation operation) {
+    if (a == NULL || b == NULL) {
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST,
+                  "Error. Attempting a set operation on a NULL list.\n");
+        return NULL;
+    }
+    //equality is only defined between lists of the same type.
+    if (a->e_type != b->e_type) {
+        set_error(WC_LINKEDLIST_ERROR_TYPE_MISMATCH,
+                  "Error. Attempting a set operation on lists of different types.\n");
+        return NULL;
+    }
+    struct value_set in_b;
+    struct value_set picked;
+    //union doesn't look values of b up, every distinct value is picked.
+    size_t b_expected = (operation == SET_UNION) ? 0 : b->length;
+    size_t picked_expected = (operation == SET_UNION) ? a->length + b->length : a->length;
+    if (!value_set_init(&in_b, a, b_expected)) {
+        return NULL;
+    }
+    if (!value_set_init(&picked, a, picked_expected)) {
+        value_set_free(&in_b);
+        return NULL;
+    }
+    struct linked_list* result = list_new_like(a);
+    if (result == NULL) {
+        value_set_free(&in_b);
+        value_set_free(&picked);
+        return NULL;
+    }
+    if (operation != SET_UNION) {
+        for (struct node* current = b->head; current != NULL; current = current->next) {
+            WC_PREFETCH(current->next);
+            value_set_insert(&in_b, current->value, current->value_length);
+        }
+    }
+    unsigned char success = 1;
+    for (struct node* current = a->head; success && current != NULL; current = current->next) {
+        WC_PREFETCH(current->next);
+        //intersect keeps values of a in b, difference values of a not in b.
+        if (operation != SET_UNION &&
+            value_set_contains(&in_b, current->value, current->value_length) !=
+            (operation == SET_INTERSECT)) {
+            continue;
+        }
+        if (value_set_add(&picked, current->value, current->value_length)) {
+            success = linked_list_add(result, current->value, current->value_length);
+        }
+    }
+    //union adds the values of b not already picked from a.
+    if (operation == SET_UNION) {
+        for (struct node* current = b->head; success && current != NULL;
+             current = current->next) {
+            WC_PREFETCH(current->next);
+            if (value_set_add(&picked, current->value, current->value_length)) {
+                success = linked_list_add(result, current->value, current->value_length);
+            }
+        }
+    }
+    value_set_free(&in_b);
+    value_set_free(&picked);
+    if (!success) {
+        linked_list_free(result);
+        return NULL;
+    }
+    return result;
+}
+
+//return a new list of the distinct values of a that are also in b.
+struct linked_list* linked_list_intersect(struct linked_list* a, struct linked_list* b) {
+    return set_combine(a, b, SET_INTERSECT);
+}
+
+//return a new list of the distinct values of a that are not in b.
+struct linked_list* linked_list_difference(struct linked_list* a, struct linked_list* b) {
+    return set_combine(a, b, SET_DIFFERENCE);
+}
+
+//return a new list of the distinct values of a, followed by those of b not
+//in a.
+struct linked_list* linked_list_union(struct linked_list* a, struct linked_list* b) {
+    return set_combine(a, b, SET_UNION);
+}
+
 /*
 * START private print functions
 */
@@ -647,7 +2323,8 @@ static void print_obj(struct node* list_head, size_t length) {
 void linked_list_print(struct linked_list* list) {
     //cannot print a NULL list.
     if (list == NULL) {
-        fputs("Error. Attempting to print out a NULL linked list.\n", stderr);
+        set_error(WC_LINKEDLIST_ERROR_NULL_LIST,
+                  "Error. Attempting to print out a NULL linked list.\n");
         return;
     }
     //make copy of front of list for iteration.
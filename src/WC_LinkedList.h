@@ -1,5 +1,6 @@
 #ifndef WC_LINKEDLIST_H
     #define WC_LINKEDLIST_H
+    #include <stdint.h>
     /*
     * Possible types for list:
     *   WC_LINKEDLIST_INT: integer stored.
@@ -17,10 +18,81 @@
         //pointer to the first byte of the item.
         void* item;
     };
+    /*
+    * Error codes raised by list functions. No list function writes to stderr;
+    * the code of the last error on a thread is available from
+    * linked_list_last_error, and every error is passed to the callback
+    * installed with linked_list_set_error_callback (if any).
+    */
+    enum linked_list_error {
+        WC_LINKEDLIST_OK, WC_LINKEDLIST_ERROR_NULL_LIST, WC_LINKEDLIST_ERROR_NULL_VALUE,
+        WC_LINKEDLIST_ERROR_NULL_ARGUMENT, WC_LINKEDLIST_ERROR_OUT_OF_BOUNDS,
+        WC_LINKEDLIST_ERROR_EMPTY_LIST, WC_LINKEDLIST_ERROR_OUT_OF_MEMORY,
+        WC_LINKEDLIST_ERROR_INVALID_STATE, WC_LINKEDLIST_ERROR_TYPE_MISMATCH
+    };
+    //callback called with every error raised. message is a static string
+    //describing where the error happened. ctx is the pointer passed to
+    //linked_list_set_error_callback.
+    typedef void (*linked_list_error_callback)(enum linked_list_error error,
+                                               const char* message, void* ctx);
+    //Allocator hooks used by a list for every allocation it makes: the list
+    //itself, its nodes, its values and its iterators. ctx is the pointer
+    //passed to linked_list_new_with_allocator.
+    struct wc_allocator {
+        //allocate size bytes. return NULL on failure.
+        void* (*alloc)(size_t size, void* ctx);
+        //resize an allocation made by alloc. return NULL on failure.
+        void* (*realloc)(void* ptr, size_t size, void* ctx);
+        //release an allocation made by alloc or realloc.
+        void (*free)(void* ptr, void* ctx);
+        //optional, may be NULL. When set, linked_list_free calls reset once
+        //instead of freeing each node. (useful for region allocators). ctx
+        //must then only be used by one list; lists derived from it (clones
+        //and set operation results) are allocated with the default allocator.
+        void (*reset)(void* ctx);
+    };
+    //Random number generator used by the sampling functions. uniform returns a
+    //random value in [0, upper_bound); ctx is passed to it. Passing a NULL
+    //generator to those functions uses libsodium's randombytes_uniform.
+    struct linked_list_rng {
+        uint32_t (*uniform)(uint32_t upper_bound, void* ctx);
+        void* ctx;
+    };
+    //state for a fast seedable (not cryptographically secure) generator. use
+    //linked_list_fast_rng_uniform as uniform, and a pointer to it as ctx.
+    struct linked_list_fast_rng {
+        uint64_t state;
+    };
+    //Equality callback of a list set up with linked_list_set_ops. key is
+    //what was passed to a lookup, or another element of a list for
+    //linked_list_unique and the set operations. element is an element of the
+    //list. ctx is the pointer passed to linked_list_set_ops.
+    //return 1 when key matches element. 0 Otherwise.
+    typedef unsigned char (*linked_list_eq_fn)(const void* key, size_t key_length,
+                                               const void* element, size_t element_length,
+                                               void* ctx);
+    //Hash callback of a list set up with linked_list_set_ops. elements
+    //matching under the equality callback must hash the same.
+    typedef uint64_t (*linked_list_hash_fn)(const void* element, size_t element_length,
+                                            void* ctx);
     //define linked_list type (forward declared).
     struct linked_list;
+    //define string intern table (forward declared).
+    struct linked_list_intern_table;
     //define linked list iterator (forward declared).
     struct linked_list_iterator;
+    //Error functions:
+    //return the code of the last error raised on the calling thread.
+    //successful calls do not reset it. (see linked_list_clear_error).
+    enum linked_list_error linked_list_last_error(void);
+    //reset the last error of the calling thread to WC_LINKEDLIST_OK.
+    void linked_list_clear_error(void);
+    //install a callback called with every error raised, on the thread that
+    //raised it. passing NULL removes the callback. (the default).
+    //should not be changed while other threads are using lists.
+    void linked_list_set_error_callback(linked_list_error_callback callback, void* ctx);
+    //return a static description of an error code.
+    const char* linked_list_error_string(enum linked_list_error error);
     //List iterator functions:
     //create a new struct linked_list_iterator and return it.
     //will return NULL on failure. 
@@ -35,14 +107,76 @@
     //a new iterator the first element in the list will be returned.
     //will return NULL on error.
     void* linked_list_get_next(struct linked_list_iterator* list_it);
+    //Intern table functions:
+    //create a table that identical strings of WC_LINKEDLIST_STRING lists are
+    //stored in once, refcounted. can be shared between lists, but is not
+    //thread safe. will return NULL on failure.
+    struct linked_list_intern_table* linked_list_intern_table_new(void);
+    //free an intern table. lists using it must be freed first.
+    void linked_list_intern_table_free(struct linked_list_intern_table* table);
+    //return the number of distinct strings in an intern table.
+    size_t linked_list_intern_table_size(struct linked_list_intern_table* table);
     //List functions:
     //free an allocated struct linked_list.
     void linked_list_free(struct linked_list* list_to_free);
+    //hand a list over to a background reclaimer thread, which frees it in
+    //batches. returns in O(1); the list must not be used afterwards. allocator
+    //hooks and error callbacks for the list are then called from that thread.
+    //lists using a shared intern table are freed on the calling thread.
+    void linked_list_free_async(struct linked_list* list_to_free);
+    //wait until every list handed to linked_list_free_async has been freed.
+    void linked_list_reclaimer_drain(void);
+    //throttle the reclaimer: sleep for microseconds between batches of freed
+    //nodes. 0 (the default) doesn't sleep.
+    void linked_list_reclaimer_set_delay(unsigned int microseconds);
     //create a new struct linked_list.
     struct linked_list* linked_list_new(enum linked_list_type type);
+    //create a new struct linked_list that makes all of its allocations through
+    //the allocator passed. ctx is passed to each allocator hook.
+    //allocator must outlive the list. will return NULL on failure.
+    struct linked_list* linked_list_new_with_allocator(enum linked_list_type type,
+                                                       const struct wc_allocator* allocator,
+                                                       void* ctx);
+    //create a new struct linked_list whose elements are compared through eq_fn
+    //by linked_list_contains, linked_list_find, the removal and set functions.
+    //hash_fn is used by linked_list_unique and the set operations; when NULL
+    //they fall back to comparing every pair. ctx is passed to both.
+    //will return NULL on failure.
+    struct linked_list* linked_list_new_with_ops(enum linked_list_type type,
+                                                 linked_list_eq_fn eq_fn,
+                                                 linked_list_hash_fn hash_fn, void* ctx);
+    //compare the elements of an empty list through eq_fn (and hash them
+    //through hash_fn), as linked_list_new_with_ops does. lets custom equality
+    //be combined with linked_list_new_with_allocator. interned lists can't
+    //use custom equality. will return 1 on success. 0 Otherwise.
+    unsigned char linked_list_set_ops(struct linked_list* list, linked_list_eq_fn eq_fn,
+                                      linked_list_hash_fn hash_fn, void* ctx);
+    //intern the values of an empty WC_LINKEDLIST_STRING list: identical strings
+    //share one buffer of table, and are compared by pointer. a NULL table gives
+    //the list a private table, freed with the list. values returned by
+    //linked_list_get are shared and must not be modified.
+    //will return 1 on success. 0 Otherwise.
+    unsigned char linked_list_enable_interning(struct linked_list* list,
+                                               struct linked_list_intern_table* table);
+    //copy the nodes and values of a list into one contiguous block of memory,
+    //in list order, and free the old scattered ones. restores locality after
+    //heavy churn. iterators created before compacting must not be used after.
+    //will return 1 on success. 0 Otherwise. (the list is unchanged on failure).
+    unsigned char linked_list_compact(struct linked_list* list);
     //add an element to the struct linked_list, obj_length is how many bytes the element passed is.
     //make sure that obj_length includes the null terminator if value is a string.
     unsigned char linked_list_add(struct linked_list* list, void* value, size_t obj_length);
+    //insert an element into the struct linked_list so that it ends up at index.
+    //index may be the length of the list to add to the end of it.
+    //will return 1 on success. 0 Otherwise.
+    unsigned char linked_list_insert_at(struct linked_list* list, size_t index, void* value,
+                                        size_t obj_length);
+    //index a list: its nodes are threaded into an indexable skip list, making
+    //linked_list_get, linked_list_set, linked_list_insert_at and
+    //linked_list_remove_at O(log n) instead of O(n). The list stays indexed
+    //until freed; iterators created before indexing must not be used after.
+    //will return 1 on success. 0 Otherwise.
+    unsigned char linked_list_enable_index(struct linked_list* list);
     //Get the value at the passed index of the list
     //returns NULL on failure.
     //item within list_value is a valid pointer in the list.
@@ -54,7 +188,14 @@
     unsigned char linked_list_set(struct linked_list* list, size_t index, void* value, size_t obj_length);
     //check whether the list contains a value
     //returns 1 if the value exists in the list. 0 when the value isn't there.
+    //(an empty list is not an error, no error is raised).
     unsigned char linked_list_contains(struct linked_list* list, void* value, size_t obj_length);
+    //find the first element of the list matching key. (through the list's
+    //equality callback if it has one). on success out is set to the element
+    //in place. (see linked_list_get). returns 1 when found. 0 Otherwise.
+    //(like linked_list_contains, no error is raised for an empty list).
+    unsigned char linked_list_find(struct linked_list* list, void* key, size_t key_length,
+                                   struct list_value* out);
     //return the length of the list
     //returns a size of 0 when the list is NULL.
     size_t linked_list_size(struct linked_list* list);
@@ -62,12 +203,50 @@
     struct linked_list* linked_list_clone(struct linked_list* list);
     //shuffle the order of values in the linked list
     void linked_list_shuffle(struct linked_list* list);
+    //seed a fast generator. the same seed gives the same sequence of values.
+    void linked_list_fast_rng_seed(struct linked_list_fast_rng* rng, uint64_t seed);
+    //uniform function of the fast generator. ctx is a struct linked_list_fast_rng*.
+    uint32_t linked_list_fast_rng_uniform(uint32_t upper_bound, void* ctx);
+    //pick up to k random elements of the list in a single pass without
+    //modifying or copying it. (reservoir sampling). out_values must have room
+    //for k values; the items point into the list. rng may be NULL.
+    //returns the number of elements picked: k, or the list length if smaller.
+    size_t linked_list_sample(struct linked_list* list, size_t k, struct list_value out_values[],
+                              const struct linked_list_rng* rng);
+    //pick a random element of the list. rng may be NULL.
+    //item within list_value is NULL on failure. (NULL or empty list).
+    struct list_value linked_list_random_element(struct linked_list* list,
+                                                 const struct linked_list_rng* rng);
     //remove an element from the list using an index.
     //will return 1 on success. 0 Otherwise. (NULL list passed, out of bounds, empty list, etc.)
     unsigned char linked_list_remove_at(struct linked_list* list, size_t index);
     //remove an element from the list using a value stored in it.
     //will return 1 on success. 0 Otherwise.
     int linked_list_remove_value(struct linked_list* list, void* value, size_t obj_length);
+    //predicate used by linked_list_remove_if. value and value_length describe
+    //an element of the list, ctx is the pointer passed to linked_list_remove_if.
+    //return 1 for the element to be removed. 0 Otherwise.
+    typedef unsigned char (*linked_list_predicate)(void* value, size_t value_length, void* ctx);
+    //remove every element equal to value from the list in a single pass.
+    //returns the number of elements removed.
+    size_t linked_list_remove_all_values(struct linked_list* list, void* value, size_t obj_length);
+    //remove every element of the list that predicate returns 1 for in a single
+    //pass. returns the number of elements removed.
+    size_t linked_list_remove_if(struct linked_list* list, linked_list_predicate predicate, void* ctx);
+    //Set operations: equality follows the type of the lists. (including the
+    //allowed inaccuracy of WC_LINKEDLIST_DOUBLE lists). expected linear time.
+    //remove every element equal to an element before it, in place.
+    //returns the number of elements removed.
+    size_t linked_list_unique(struct linked_list* list);
+    //return a new list of the distinct values of a that are also in b.
+    //the lists must be of the same type. will return NULL on failure.
+    //returned list must be freed using linked_list_free.
+    struct linked_list* linked_list_intersect(struct linked_list* a, struct linked_list* b);
+    //return a new list of the distinct values of a that are not in b.
+    struct linked_list* linked_list_difference(struct linked_list* a, struct linked_list* b);
+    //return a new list of the distinct values of a, followed by the distinct
+    //values of b that are not in a.
+    struct linked_list* linked_list_union(struct linked_list* a, struct linked_list* b);
     //print out all of the elements of a linked list.
     //will print out the hex values for a list of type WC_LINKEDLIST_OBJ
     void linked_list_print(struct linked_list* list);
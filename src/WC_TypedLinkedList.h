@@ -0,0 +1,250 @@
+#ifndef WC_TYPEDLINKEDLIST_H
+    #define WC_TYPEDLINKEDLIST_H
+    #include <stdlib.h>
+    #include <math.h>
+    #include "WC_LinkedList.h"
+    /*
+    * Header only generator for type specialized lists.
+    *
+    * WC_LINKEDLIST_DECLARE(name, T, eq_fn) emits a list named struct name
+    * whose values of type T are stored inline in each node. (no void*, no
+    * stored length and no memcpy). eq_fn(T a, T b) returns non zero when a and
+    * b are equal; it may be a function or a function like macro.
+    *
+    * Functions emitted: (all static inline)
+    *   struct name* name_new(void): NULL on failure.
+    *   struct name* name_new_with_allocator(const struct wc_allocator* a, void* ctx)
+    *       the list and its nodes are allocated through a; NULL uses malloc.
+    *       (see struct wc_allocator, reset is honoured by name_free).
+    *   void name_free(struct name* list)
+    *   unsigned char name_add(struct name* list, T value): 1 on success.
+    *   T* name_get(struct name* list, size_t index): NULL when out of bounds.
+    *   unsigned char name_set(struct name* list, size_t index, T value)
+    *   unsigned char name_contains(struct name* list, T value)
+    *   unsigned char name_remove_at(struct name* list, size_t index)
+    *   unsigned char name_remove_value(struct name* list, T value)
+    *   size_t name_size(struct name* list)
+    *   struct name_iterator name_get_iterator(struct name* list)
+    *   unsigned char name_has_next(struct name_iterator* list_it)
+    *   T* name_get_next(struct name_iterator* list_it): NULL when done.
+    *
+    * Example:
+    *   WC_LINKEDLIST_DECLARE(int_list, int, wc_linkedlist_int_eq)
+    */
+
+    //equality functions for the types supported by struct linked_list.
+    static inline unsigned char wc_linkedlist_int_eq(int value_one, int value_two) {
+        return value_one == value_two;
+    }
+    //same allowed inaccuracy as WC_LINKEDLIST_DOUBLE lists.
+    static inline unsigned char wc_linkedlist_double_eq(double value_one, double value_two) {
+        return fabs(value_one - value_two) < 0.00001;
+    }
+
+    #define WC_LINKEDLIST_DECLARE(name, T, eq_fn)                                \
+    struct name##_node {                                                       \
+        /*value stored inline in the node.*/                                   \
+        T value;                                                               \
+        /*next node in the list.*/                                             \
+        struct name##_node* next;                                              \
+    };                                                                         \
+    struct name {                                                              \
+        /*front node of the list.*/                                            \
+        struct name##_node* head;                                              \
+        /*end of the list.*/                                                   \
+        struct name##_node* tail;                                              \
+        /*number of nodes in the list.*/                                       \
+        size_t length;                                                         \
+        /*allocator used for the list and its nodes. NULL for malloc.*/        \
+        const struct wc_allocator* allocator;                                  \
+        /*context passed to each allocator hook.*/                             \
+        void* allocator_ctx;                                                   \
+    };                                                                         \
+    struct name##_iterator {                                                   \
+        /*node returned by the next call to get_next.*/                        \
+        struct name##_node* next;                                              \
+    };                                                                         \
+                                                                               \
+    /*allocate size bytes through the allocator of list.*/                     \
+    static inline void* name##_alloc(struct name* list, size_t size) {         \
+        if (list->allocator == NULL) {                                         \
+            return malloc(size);                                               \
+        }                                                                      \
+        return list->allocator->alloc(size, list->allocator_ctx);              \
+    }                                                                          \
+                                                                               \
+    /*free memory allocated through name##_alloc.*/                            \
+    static inline void name##_dealloc(struct name* list, void* ptr) {          \
+        if (list->allocator == NULL) {                                         \
+            free(ptr);                                                         \
+        } else {                                                               \
+            list->allocator->free(ptr, list->allocator_ctx);                   \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static inline struct name* name##_new_with_allocator(                      \
+        const struct wc_allocator* allocator, void* ctx) {                     \
+        struct name* new_list = (allocator == NULL) ?                          \
+            malloc(sizeof(struct name)) :                                      \
+            allocator->alloc(sizeof(struct name), ctx);                        \
+        if (new_list == NULL) {                                                \
+            return NULL;                                                       \
+        }                                                                      \
+        new_list->head = NULL;                                                 \
+        new_list->tail = NULL;                                                 \
+        new_list->length = 0;                                                  \
+        new_list->allocator = allocator;                                       \
+        new_list->allocator_ctx = ctx;                                         \
+        return new_list;                                                       \
+    }                                                                          \
+                                                                               \
+    static inline struct name* name##_new(void) {                              \
+        return name##_new_with_allocator(NULL, NULL);                          \
+    }                                                                          \
+                                                                               \
+    static inline void name##_free(struct name* list) {                        \
+        if (list == NULL) {                                                    \
+            return;                                                            \
+        }                                                                      \
+        /*a region allocator releases the list and its nodes at once.*/        \
+        if (list->allocator != NULL && list->allocator->reset != NULL) {       \
+            list->allocator->reset(list->allocator_ctx);                       \
+            return;                                                            \
+        }                                                                      \
+        struct name##_node* current = list->head;                              \
+        while (current != NULL) {                                              \
+            struct name##_node* next = current->next;                          \
+            name##_dealloc(list, current);                                     \
+            current = next;                                                    \
+        }                                                                      \
+        name##_dealloc(list, list);                                            \
+    }                                                                          \
+                                                                               \
+    static inline unsigned char name##_add(struct name* list, T value) {       \
+        if (list == NULL) {                                                    \
+            return 0;                                                          \
+        }                                                                      \
+        struct name##_node* new_node =                                         \
+            name##_alloc(list, sizeof(struct name##_node));                    \
+        if (new_node == NULL) {                                                \
+            return 0;                                                          \
+        }                                                                      \
+        new_node->value = value;                                               \
+        new_node->next = NULL;                                                 \
+        if (list->head == NULL) {                                              \
+            list->head = new_node;                                             \
+        } else {                                                               \
+            list->tail->next = new_node;                                       \
+        }                                                                      \
+        list->tail = new_node;                                                 \
+        list->length++;                                                        \
+        return 1;                                                              \
+    }                                                                          \
+                                                                               \
+    static inline struct name##_node* name##_get_node(struct name* list,       \
+                                                      size_t index) {          \
+        if (list == NULL || index >= list->length) {                           \
+            return NULL;                                                       \
+        }                                                                      \
+        struct name##_node* current = list->head;                              \
+        for (size_t i = 0; i < index; i++) {                                   \
+            current = current->next;                                           \
+        }                                                                      \
+        return current;                                                        \
+    }                                                                          \
+                                                                               \
+    static inline T* name##_get(struct name* list, size_t index) {             \
+        struct name##_node* found = name##_get_node(list, index);              \
+        return (found == NULL) ? NULL : &found->value;                         \
+    }                                                                          \
+                                                                               \
+    static inline unsigned char name##_set(struct name* list, size_t index,    \
+                                           T value) {                          \
+        struct name##_node* found = name##_get_node(list, index);              \
+        if (found == NULL) {                                                   \
+            return 0;                                                          \
+        }                                                                      \
+        found->value = value;                                                  \
+        return 1;                                                              \
+    }                                                                          \
+                                                                               \
+    static inline unsigned char name##_contains(struct name* list, T value) {  \
+        if (list == NULL) {                                                    \
+            return 0;                                                          \
+        }                                                                      \
+        for (struct name##_node* current = list->head; current != NULL;        \
+             current = current->next) {                                        \
+            if (eq_fn(current->value, value)) {                                \
+                return 1;                                                      \
+            }                                                                  \
+        }                                                                      \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    /*unlink the node after previous. (previous NULL unlinks the head).*/      \
+    static inline void name##_unlink(struct name* list,                        \
+                                     struct name##_node* previous) {           \
+        struct name##_node* node_to_free =                                     \
+            (previous == NULL) ? list->head : previous->next;                  \
+        if (previous == NULL) {                                                \
+            list->head = node_to_free->next;                                   \
+        } else {                                                               \
+            previous->next = node_to_free->next;                               \
+        }                                                                      \
+        if (node_to_free == list->tail) {                                      \
+            list->tail = previous;                                             \
+        }                                                                      \
+        name##_dealloc(list, node_to_free);                                    \
+        list->length--;                                                        \
+    }                                                                          \
+                                                                               \
+    static inline unsigned char name##_remove_at(struct name* list,            \
+                                                 size_t index) {               \
+        if (list == NULL || index >= list->length) {                           \
+            return 0;                                                          \
+        }                                                                      \
+        name##_unlink(list, (index == 0) ? NULL                                \
+                                         : name##_get_node(list, index - 1));  \
+        return 1;                                                              \
+    }                                                                          \
+                                                                               \
+    static inline unsigned char name##_remove_value(struct name* list,         \
+                                                    T value) {                 \
+        if (list == NULL) {                                                    \
+            return 0;                                                          \
+        }                                                                      \
+        struct name##_node* previous = NULL;                                   \
+        for (struct name##_node* current = list->head; current != NULL;        \
+             current = current->next) {                                        \
+            if (eq_fn(current->value, value)) {                                \
+                name##_unlink(list, previous);                                 \
+                return 1;                                                      \
+            }                                                                  \
+            previous = current;                                                \
+        }                                                                      \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    static inline size_t name##_size(struct name* list) {                      \
+        return (list == NULL) ? 0 : list->length;                              \
+    }                                                                          \
+                                                                               \
+    static inline struct name##_iterator name##_get_iterator(struct name* list) { \
+        struct name##_iterator list_it;                                        \
+        list_it.next = (list == NULL) ? NULL : list->head;                     \
+        return list_it;                                                        \
+    }                                                                          \
+                                                                               \
+    static inline unsigned char name##_has_next(struct name##_iterator* list_it) { \
+        return list_it->next != NULL;                                          \
+    }                                                                          \
+                                                                               \
+    static inline T* name##_get_next(struct name##_iterator* list_it) {        \
+        struct name##_node* current = list_it->next;                           \
+        if (current == NULL) {                                                 \
+            return NULL;                                                       \
+        }                                                                      \
+        list_it->next = current->next;                                         \
+        return &current->value;                                                \
+    }
+#endif
@@ -1,6 +1,9 @@
 #include <stdio.h>
 #include <string.h>
 #include "WC_LinkedList.h"
+#include "WC_TypedLinkedList.h"
+
+WC_LINKEDLIST_DECLARE(int_list, int, wc_linkedlist_int_eq)
 
 void modify_string_list(struct linked_list* str_list) {
     printf("\nAdding 10 duplicate string elements to the list...\n");
@@ -25,6 +28,24 @@ void modify_string_list(struct linked_list* str_list) {
 
     printf("\nPrinting out the length of the list...\n");
     printf("List length: %ld\n", (unsigned long)linked_list_size(str_list));
+
+    printf("\nTesting removal of all duplicate elements by value...\n");
+    char other_string[] = "GOODBYE LIST";
+    linked_list_add(str_list, other_string, strlen(other_string) + 1);
+    size_t removed = linked_list_remove_all_values(str_list, random_string,
+                                                   strlen(random_string) + 1);
+    printf("Elements removed: %ld.\nState of list:\n", (unsigned long)removed);
+    linked_list_print(str_list);
+
+    printf("\nAdding back an element after the tail was removed...\n");
+    linked_list_add(str_list, random_string, strlen(random_string) + 1);
+    linked_list_print(str_list);
+}
+
+static unsigned char is_even(void* value, size_t value_length, void* ctx) {
+    (void)value_length;
+    (void)ctx;
+    return (*(int*)value % 2) == 0;
 }
 
 void modify_int_list(struct linked_list* int_list) {
@@ -46,6 +67,11 @@ void modify_int_list(struct linked_list* int_list) {
     success = linked_list_remove_value(int_list, &int_to_remove, sizeof(int));
     printf("Status of element removal: %d.\nState of list:\n", success);
     linked_list_print(int_list);
+
+    printf("\nTesting removal of all even elements...\n");
+    size_t removed = linked_list_remove_if(int_list, is_even, NULL);
+    printf("Elements removed: %ld.\nState of list:\n", (unsigned long)removed);
+    linked_list_print(int_list);
 }
 
 void modify_double_list(struct linked_list* doub_list) {
@@ -87,6 +113,13 @@ void modify_double_list(struct linked_list* doub_list) {
         printf("%f\n", *(double*)linked_list_get_next(double_iter));
     }
     linked_list_free_iterator(double_iter);
+
+    printf("\nCompacting the double list, then setting element 2 to 2.5...\n");
+    success = linked_list_compact(doub_list);
+    double two_and_a_half = 2.5;
+    linked_list_set(doub_list, 2, &two_and_a_half, sizeof(double));
+    printf("Status of compaction: %d.\nState of list:\n", success);
+    linked_list_print(doub_list);
 }
 
 void modify_arb_list(struct linked_list* arb_list) {
@@ -125,17 +158,347 @@ void modify_arb_list(struct linked_list* arb_list) {
     linked_list_free(cloned_arb_list);
     printf("Cloned list freed.\n");
 
+    printf("\nSampling 3 elements of the arbitrary list with a seeded generator...\n");
+    struct linked_list_fast_rng fast_rng;
+    linked_list_fast_rng_seed(&fast_rng, 1234);
+    struct linked_list_rng rng = {linked_list_fast_rng_uniform, &fast_rng};
+    struct list_value samples[3];
+    size_t sampled = linked_list_sample(arb_list, 3, samples, &rng);
+    printf("Elements sampled: %ld. First sample length: %ld\n", (unsigned long)sampled,
+           (unsigned long)samples[0].item_length);
+
+    printf("\nPicking a random element of the arbitrary list...\n");
+    struct list_value random_element = linked_list_random_element(arb_list, NULL);
+    printf("Random element length: %ld\n", (unsigned long)random_element.item_length);
+
     printf("\nShuffling the arbitrary list...\n");
     linked_list_shuffle(arb_list);
     linked_list_print(arb_list);
 }
 
+//simple region allocator: every allocation is bumped out of one buffer and
+//the whole region is released by resetting the offset.
+struct region {
+    unsigned char buffer[4096];
+    size_t offset;
+};
+
+static void* region_alloc(size_t size, void* ctx) {
+    struct region* r = ctx;
+    //keep every allocation aligned for any type.
+    size_t aligned_size = (size + 15) & ~(size_t)15;
+    if (r->offset + aligned_size > sizeof(r->buffer)) {
+        return NULL;
+    }
+    void* allocation = r->buffer + r->offset;
+    r->offset += aligned_size;
+    return allocation;
+}
+
+static void* region_realloc(void* ptr, size_t size, void* ctx) {
+    void* allocation = region_alloc(size, ctx);
+    //old allocations are never smaller than what is copied out of them
+    //in this test, as values only ever grow.
+    if (allocation != NULL && ptr != NULL) {
+        memcpy(allocation, ptr, size);
+    }
+    return allocation;
+}
+
+static void region_free(void* ptr, void* ctx) {
+    (void)ptr;
+    (void)ctx;
+}
+
+static void region_reset(void* ctx) {
+    ((struct region*)ctx)->offset = 0;
+}
+
+void modify_region_list(void) {
+    static struct region r;
+    const struct wc_allocator region_allocator = {
+        region_alloc, region_realloc, region_free, region_reset
+    };
+    printf("\nCreating an integer list inside of a region...\n");
+    struct linked_list* region_list = linked_list_new_with_allocator(WC_LINKEDLIST_INT,
+                                                                     &region_allocator, &r);
+    for (int i = 1; i <= 10; i++) {
+        linked_list_add(region_list, &i, sizeof(int));
+    }
+    linked_list_print(region_list);
+    printf("Region bytes used: %ld\n", (unsigned long)r.offset);
+
+    printf("\nCloning the region list, then freeing the clone...\n");
+    struct linked_list* region_clone = linked_list_clone(region_list);
+    linked_list_free(region_clone);
+    int eleven = 11;
+    linked_list_add(region_list, &eleven, sizeof(int));
+    linked_list_print(region_list);
+    printf("Region bytes used: %ld\n", (unsigned long)r.offset);
+
+    printf("\nFreeing the region list...\n");
+    linked_list_free(region_list);
+    printf("Region bytes used: %ld\n", (unsigned long)r.offset);
+}
+
+void modify_indexed_list(struct linked_list* indexed_list) {
+    printf("\nAdding 10 integers to the list, then indexing it...\n");
+
+    for (int i = 1; i <= 10; i++) {
+        linked_list_add(indexed_list, &i, sizeof(int));
+    }
+    unsigned char success = linked_list_enable_index(indexed_list);
+    printf("Status of indexing: %d.\nState of list:\n", success);
+    linked_list_print(indexed_list);
+
+    printf("\nInserting 100 at the front, 200 at index 5 and 300 at the end...\n");
+    int inserted[] = {100, 200, 300};
+    linked_list_insert_at(indexed_list, 0, &inserted[0], sizeof(int));
+    linked_list_insert_at(indexed_list, 5, &inserted[1], sizeof(int));
+    linked_list_insert_at(indexed_list, linked_list_size(indexed_list), &inserted[2], sizeof(int));
+    linked_list_print(indexed_list);
+
+    printf("\nRetrieving the value at element 5: %d\n",
+           *(int*)linked_list_get(indexed_list, 5).item);
+
+    printf("\nRemoving element 0 and the value 200, then adding 11...\n");
+    linked_list_remove_at(indexed_list, 0);
+    linked_list_remove_value(indexed_list, &inserted[1], sizeof(int));
+    int eleven = 11;
+    linked_list_add(indexed_list, &eleven, sizeof(int));
+    linked_list_print(indexed_list);
+
+    printf("\nTesting iteration of indexed list...\n");
+    struct linked_list_iterator* indexed_iter = linked_list_get_iterator(indexed_list);
+
+    while (linked_list_has_next(indexed_iter)) {
+        printf("%d ", *(int*)linked_list_get_next(indexed_iter));
+    }
+    printf("\n");
+    linked_list_free_iterator(indexed_iter);
+}
+
+void modify_interned_lists(void) {
+    printf("\nAdding hostnames to two string lists sharing an intern table...\n");
+    struct linked_list_intern_table* table = linked_list_intern_table_new();
+    struct linked_list* first_list = linked_list_new(WC_LINKEDLIST_STRING);
+    struct linked_list* second_list = linked_list_new(WC_LINKEDLIST_STRING);
+    linked_list_enable_interning(first_list, table);
+    linked_list_enable_interning(second_list, table);
+    char* hosts[] = {"alpha.local", "beta.local", "alpha.local", "gamma.local"};
+
+    for (int i = 0; i < 4; i++) {
+        linked_list_add(first_list, hosts[i], strlen(hosts[i]) + 1);
+        linked_list_add(second_list, hosts[3 - i], strlen(hosts[3 - i]) + 1);
+    }
+    linked_list_print(first_list);
+    linked_list_print(second_list);
+    printf("Distinct strings stored: %ld\n", (unsigned long)linked_list_intern_table_size(table));
+    printf("Elements 0 and 2 share a buffer: %d\n",
+           linked_list_get(first_list, 0).item == linked_list_get(first_list, 2).item);
+
+    printf("\nSetting element 1 of the first list, and removing alpha.local from it...\n");
+    char delta[] = "delta.local";
+    linked_list_set(first_list, 1, delta, strlen(delta) + 1);
+    size_t removed = linked_list_remove_all_values(first_list, hosts[0], strlen(hosts[0]) + 1);
+    printf("Elements removed: %ld.\nState of list:\n", (unsigned long)removed);
+    linked_list_print(first_list);
+    printf("Contains beta.local: %d\n",
+           linked_list_contains(first_list, hosts[1], strlen(hosts[1]) + 1));
+    printf("Distinct strings stored: %ld\n", (unsigned long)linked_list_intern_table_size(table));
+
+    linked_list_free(first_list);
+    linked_list_free(second_list);
+    printf("Distinct strings stored after freeing: %ld\n",
+           (unsigned long)linked_list_intern_table_size(table));
+    linked_list_intern_table_free(table);
+}
+
+void modify_set_lists(void) {
+    printf("\nAdding IDs with duplicates to two integer lists...\n");
+    struct linked_list* first_ids = linked_list_new(WC_LINKEDLIST_INT);
+    struct linked_list* second_ids = linked_list_new(WC_LINKEDLIST_INT);
+    int first[] = {1, 2, 2, 3, 4, 4, 5};
+    int second[] = {4, 5, 6, 6, 7};
+
+    for (int i = 0; i < 7; i++) {
+        linked_list_add(first_ids, &first[i], sizeof(int));
+    }
+    for (int i = 0; i < 5; i++) {
+        linked_list_add(second_ids, &second[i], sizeof(int));
+    }
+    linked_list_print(first_ids);
+    linked_list_print(second_ids);
+
+    printf("\nIntersection, difference and union of the lists:\n");
+    struct linked_list* results[] = {
+        linked_list_intersect(first_ids, second_ids),
+        linked_list_difference(first_ids, second_ids),
+        linked_list_union(first_ids, second_ids)
+    };
+    for (int i = 0; i < 3; i++) {
+        linked_list_print(results[i]);
+        linked_list_free(results[i]);
+    }
+
+    printf("\nRemoving duplicates from the first list...\n");
+    size_t removed = linked_list_unique(first_ids);
+    printf("Elements removed: %ld.\nState of list:\n", (unsigned long)removed);
+    linked_list_print(first_ids);
+    linked_list_free(first_ids);
+    linked_list_free(second_ids);
+}
+
+struct record {
+    int id;
+    double score;
+};
+
+//records are keyed by id. keys are either a bare id or another record.
+static unsigned char record_id_eq(const void* key, size_t key_length,
+                                  const void* element, size_t element_length, void* ctx) {
+    (void)element_length;
+    (void)ctx;
+    int key_id = (key_length == sizeof(int)) ? *(const int*)key
+                                             : ((const struct record*)key)->id;
+    return key_id == ((const struct record*)element)->id;
+}
+
+static uint64_t record_id_hash(const void* element, size_t element_length, void* ctx) {
+    (void)element_length;
+    (void)ctx;
+    return (uint64_t)((const struct record*)element)->id * 0x9E3779B97F4A7C15ULL;
+}
+
+void modify_keyed_list(void) {
+    printf("\nAdding records to a list keyed by id...\n");
+    struct linked_list* records = linked_list_new_with_ops(WC_LINKEDLIST_OBJ, record_id_eq,
+                                                           record_id_hash, NULL);
+    for (int i = 0; i < 6; i++) {
+        struct record new_record = {i % 4, i * 1.5};
+        linked_list_add(records, &new_record, sizeof(struct record));
+    }
+    printf("Records added: %ld\n", (unsigned long)linked_list_size(records));
+
+    printf("\nLooking up the record with id 3...\n");
+    int id = 3;
+    struct list_value found;
+    if (linked_list_find(records, &id, sizeof(int), &found)) {
+        printf("Found record %d with score %f\n", ((struct record*)found.item)->id,
+               ((struct record*)found.item)->score);
+    }
+
+    printf("\nRemoving duplicate ids, then every record with id 0...\n");
+    size_t removed = linked_list_unique(records);
+    id = 0;
+    removed += linked_list_remove_all_values(records, &id, sizeof(int));
+    printf("Elements removed: %ld. Contains id 0: %d\n", (unsigned long)removed,
+           linked_list_contains(records, &id, sizeof(int)));
+    linked_list_free(records);
+
+    printf("\nAdding records to a list keyed by id inside of a region...\n");
+    static struct region r;
+    const struct wc_allocator region_allocator = {
+        region_alloc, region_realloc, region_free, region_reset
+    };
+    struct linked_list* region_records = linked_list_new_with_allocator(WC_LINKEDLIST_OBJ,
+                                                                        &region_allocator, &r);
+    unsigned char success = linked_list_set_ops(region_records, record_id_eq, record_id_hash, NULL);
+    for (int i = 0; i < 6; i++) {
+        struct record new_record = {i, i * 2.5};
+        linked_list_add(region_records, &new_record, sizeof(struct record));
+    }
+    id = 4;
+    printf("Status of setting ops: %d. Contains id 4: %d. Region bytes used: %ld\n", success,
+           linked_list_contains(region_records, &id, sizeof(int)), (unsigned long)r.offset);
+    linked_list_free(region_records);
+}
+
+void modify_typed_list(void) {
+    printf("\nAdding 10 integers to a typed list...\n");
+    struct int_list* typed_list = int_list_new();
+
+    for (int i = 1; i <= 10; i++) {
+        int_list_add(typed_list, i);
+    }
+    printf("Elements added. State of list:\n");
+    struct int_list_iterator typed_iter = int_list_get_iterator(typed_list);
+
+    while (int_list_has_next(&typed_iter)) {
+        printf("%d ", *int_list_get_next(&typed_iter));
+    }
+    printf("\n");
+
+    printf("\nSetting element 2 to 42, and removing element 9 and value 5...\n");
+    int_list_set(typed_list, 2, 42);
+    int_list_remove_at(typed_list, 9);
+    unsigned char success = int_list_remove_value(typed_list, 5);
+    printf("Status of element removal: %d.\n", success);
+    printf("Element 2: %d, contains 5: %d, length: %ld\n", *int_list_get(typed_list, 2),
+           int_list_contains(typed_list, 5), (unsigned long)int_list_size(typed_list));
+    int_list_free(typed_list);
+
+    printf("\nAdding 10 integers to a typed list inside of a region...\n");
+    static struct region r;
+    const struct wc_allocator region_allocator = {
+        region_alloc, region_realloc, region_free, region_reset
+    };
+    struct int_list* region_list = int_list_new_with_allocator(&region_allocator, &r);
+
+    for (int i = 1; i <= 10; i++) {
+        int_list_add(region_list, i);
+    }
+    printf("Length: %ld, region bytes used: %ld\n", (unsigned long)int_list_size(region_list),
+           (unsigned long)r.offset);
+    int_list_free(region_list);
+    printf("Region bytes used after freeing: %ld\n", (unsigned long)r.offset);
+}
+
+static void print_error(enum linked_list_error error, const char* message, void* ctx) {
+    (void)ctx;
+    printf("Error callback (%s): %s", linked_list_error_string(error), message);
+}
+
+void check_errors(void) {
+    printf("\nChecking whether a value exists in an empty list with an error callback installed...\n");
+    struct linked_list* empty_list = linked_list_new(WC_LINKEDLIST_INT);
+    int value = 1;
+    linked_list_set_error_callback(print_error, NULL);
+    linked_list_clear_error();
+    printf("%s.\n", (linked_list_contains(empty_list, &value, sizeof(int)) ? "True" : "False"));
+    printf("Found: %d\n", linked_list_find(empty_list, &value, sizeof(int), NULL));
+    printf("Last error: %s\n", linked_list_error_string(linked_list_last_error()));
+
+    printf("\nRemoving a value from, and retrieving an out of bounds element of, the empty list...\n");
+    printf("Status of element removal: %d.\n", linked_list_remove_value(empty_list, &value, sizeof(int)));
+    struct list_value out_of_bounds = linked_list_get(empty_list, 3);
+    printf("Item is NULL: %d\n", out_of_bounds.item == NULL);
+    linked_list_set_error_callback(NULL, NULL);
+    linked_list_free(empty_list);
+}
+
+void free_large_list(void) {
+    printf("\nAdding 100000 integers to a list...\n");
+    struct linked_list* large_list = linked_list_new(WC_LINKEDLIST_INT);
+
+    for (int i = 0; i < 100000; i++) {
+        linked_list_add(large_list, &i, sizeof(int));
+    }
+    printf("List length: %ld\n", (unsigned long)linked_list_size(large_list));
+
+    printf("\nHanding the list to the reclaimer, and waiting for it...\n");
+    linked_list_free_async(large_list);
+    linked_list_reclaimer_drain();
+    printf("Reclaimer drained.\n");
+}
+
 int main(void) {
     printf("Testing the creation of linked list of each type...\n");
     struct linked_list* arb_list = linked_list_new(WC_LINKEDLIST_OBJ);
     struct linked_list* int_list = linked_list_new(WC_LINKEDLIST_INT);
     struct linked_list* doub_list = linked_list_new(WC_LINKEDLIST_DOUBLE);
     struct linked_list* string_list = linked_list_new(WC_LINKEDLIST_STRING);
+    struct linked_list* indexed_list = linked_list_new(WC_LINKEDLIST_INT);
     printf("Creation completed.\n");
 
     printf("\nTesting string list...\n");
@@ -154,11 +517,44 @@ int main(void) {
     modify_arb_list(arb_list);
     printf("Arbitrary list tests completed.\n");
 
+    printf("\nTesting indexed list...\n");
+    modify_indexed_list(indexed_list);
+    printf("Indexed list tests completed.\n");
+
+    printf("\nTesting interned string lists...\n");
+    modify_interned_lists();
+    printf("Interned string list tests completed.\n");
+
+    printf("\nTesting set operations...\n");
+    modify_set_lists();
+    printf("Set operation tests completed.\n");
+
+    printf("\nTesting keyed list...\n");
+    modify_keyed_list();
+    printf("Keyed list tests completed.\n");
+
+    printf("\nTesting list with a custom allocator...\n");
+    modify_region_list();
+    printf("Custom allocator list tests completed.\n");
+
+    printf("\nTesting typed list...\n");
+    modify_typed_list();
+    printf("Typed list tests completed.\n");
+
+    printf("\nTesting error reporting...\n");
+    check_errors();
+    printf("Error reporting tests completed.\n");
+
+    printf("\nTesting background freeing of a large list...\n");
+    free_large_list();
+    printf("Background freeing tests completed.\n");
+
     printf("\nFreeing linked lists...\n");
     linked_list_free(arb_list);
     linked_list_free(int_list);
     linked_list_free(doub_list);
     linked_list_free(string_list);
+    linked_list_free(indexed_list);
     printf("Lists freed.\n");
     return 0;
 }